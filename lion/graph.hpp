@@ -3,11 +3,23 @@
 
 #include "graph/adjacency_list.hpp"
 #include "graph/adjacency_matrix.hpp"
+#include "graph/csr.hpp"
+#include "graph/compressed_csr.hpp"
+#include "graph/bidirectional_list.hpp"
+#include "graph/concurrent_list.hpp"
+#include "graph/versioned_list.hpp"
+#include "graph/packed_csr.hpp"
+#include "graph/mapped.hpp"
+#include "graph/pmr.hpp"
 #include "graph/graph.hpp"
 #include "graph/digraph.hpp"
 #include "graph/wgraph.hpp"
 #include "graph/wdigraph.hpp"
+#include "graph/sharded_digraph.hpp"
 #include "graph/algorithm.hpp"
 #include "graph/graph_traits.hpp"
+#include "graph/edge_columns.hpp"
+#include "graph/heap.hpp"
+#include "graph/vertex_interner.hpp"
 
 #endif
@@ -1,11 +1,15 @@
 #ifndef LION_ADJACENCY_LIST_WEIGHTED_HPP
 #define LION_ADJACENCY_LIST_WEIGHTED_HPP
 
+#include "../detail/parallel.hpp"
+
 #include <type_traits>
+#include <cstddef>
 #include <vector>
 #include <memory>
 #include <unordered_map>
 #include <functional>
+#include <iterator>
 #include <utility>
 #include <algorithm>
 
@@ -29,6 +33,13 @@ namespace lion::graph
 			mutable weight_type weight;
 
 			operator const vertex_type&() const { return second; }
+
+			bool operator==(const edge_type1& rhs) const {
+				return second == rhs.second && weight == rhs.weight;
+			}
+			bool operator!=(const edge_type1& rhs) const {
+				return !(*this == rhs);
+			}
 		};
 
 		struct edge_type0 
@@ -45,16 +56,62 @@ namespace lion::graph
 			typename std::allocator_traits<allocator_type>::template rebind_alloc<edge_type1>
 		>;
 
+		// temporaries of the bulk path come from the graph's allocator as well
+		template<typename T>
+		using scratch_list = std::vector<T, typename std::allocator_traits<allocator_type>::template rebind_alloc<T>>;
+
+		// the out edges of a vertex and the number of edges pointing at it
+		struct node
+		{
+			list_type list;
+			std::size_t in_degree;
+
+			bool operator==(const node& rhs) const { return list == rhs.list; }
+			bool operator!=(const node& rhs) const { return !(*this == rhs); }
+		};
+
 		std::unordered_map<
 			vertex_type,
-			list_type,
+			node,
 			std::hash<vertex_type>,
 			std::equal_to<>,
 			typename std::allocator_traits<allocator_type>::template rebind_alloc<
-				std::pair<const vertex_type, list_type>
+				std::pair<const vertex_type, node>
 			>
 		> map;
 
+		std::size_t edges = 0;
+
+		// lists of at least threshold entries also get a hash index from target to
+		// its number of occurrences, which makes adjacent() O(1) on hub vertices
+		struct hub_entry
+		{
+			std::size_t count;
+			std::size_t last;
+		};
+
+		using hub_index = std::unordered_map<
+			vertex_type,
+			hub_entry,
+			std::hash<vertex_type>,
+			std::equal_to<>,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<
+				std::pair<const vertex_type, hub_entry>
+			>
+		>;
+
+		std::unordered_map<
+			vertex_type,
+			hub_index,
+			std::hash<vertex_type>,
+			std::equal_to<>,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<
+				std::pair<const vertex_type, hub_index>
+			>
+		> hubs;
+
+		std::size_t threshold = 1024;
+
 		using map_iterator = typename decltype(map)::const_iterator;
 
 	protected:
@@ -65,41 +122,215 @@ namespace lion::graph
 		class edge_iterator;
 
 		explicit adjacency_list(const allocator_type& al = allocator_type{})
-			: map(al)
+			: map(al), hubs(al)
 		{}
 
+	private:
+		node empty_node() const { return { list_type(get_allocator()), 0 }; }
+
+		// the target becomes a vertex too, references into the map survive rehashing
+		void link(const vertex_type& key, node& source, const vertex_type& target, weight_type weight)
+		{
+			++map.insert({ target, empty_node() }).first->second.in_degree;
+			++edges;
+			source.list.push_back({ target, std::move(weight) });
+			indexed(key, source.list);
+		}
+
+		// number of entries of list that point at target, they are erased
+		static std::size_t unlink(list_type& list, const vertex_type& target)
+		{
+			const auto last = std::remove_if(list.begin(), list.end(), [&](const edge_type1& edge) {
+				return edge.second == target;
+			});
+			const auto removed = static_cast<std::size_t>(list.end() - last);
+			list.erase(last, list.end());
+			return removed;
+		}
+
+		void reindex(const vertex_type& key, const list_type& list)
+		{
+			auto& index = hubs.try_emplace(key, hub_index(get_allocator())).first->second;
+			index.clear();
+			index.reserve(list.size());
+			for (std::size_t i = 0; i < list.size(); ++i)
+			{
+				auto& entry = index.insert({ list[i].second, hub_entry{ 0, 0 } }).first->second;
+				++entry.count;
+				entry.last = i;
+			}
+		}
+
+		// keeps the index of key in step after an entry was appended to its list
+		void indexed(const vertex_type& key, const list_type& list)
+		{
+			if (list.size() < threshold) {
+				return;
+			}
+			const auto hub = hubs.find(key);
+			if (hub == hubs.end())
+			{
+				reindex(key, list);
+				return;
+			}
+			const auto i = list.size() - 1;
+			auto& entry = hub->second.insert({ list[i].second, hub_entry{ 0, 0 } }).first->second;
+			++entry.count;
+			entry.last = i;
+		}
+
+		// entries were erased from the list of key, positions have moved
+		void unindexed(const vertex_type& key, const list_type& list)
+		{
+			if (list.size() >= threshold) {
+				reindex(key, list);
+			}
+			else {
+				hubs.erase(key);
+			}
+		}
+
 	public:
 		void add_edge(const edge_type& edge) 
 		{
-			auto&&[iter, succ] = map.insert({ edge.first, list_type(get_allocator()) });
-			iter->second.push_back({ edge.second, edge.weight });
+			const auto iter = map.insert({ edge.first, empty_node() }).first;
+			link(iter->first, iter->second, edge.second, edge.weight);
 		}
 
 		void add_edge(edge_type&& edge) 
 		{
-			auto&&[iter, succ] = map.insert({ std::move(edge.first), list_type(get_allocator()) });
-			iter->second.push_back({ std::move(edge.second), std::move(edge.weight) });
+			const auto iter = map.insert({ std::move(edge.first), empty_node() }).first;
+			link(iter->first, iter->second, edge.second, std::move(edge.weight));
+		}
+
+		// large batches are grouped by source in parallel, every source then costs
+		// a single map insert and its list is grown once to its final size. a
+		// random access range of edges is grouped where it lies, anything else
+		// is copied once first; through move iterators the targets are moved
+		template<typename ForwardIterator>
+		void add_edges(ForwardIterator first, ForwardIterator last)
+		{
+			using traits = std::iterator_traits<ForwardIterator>;
+			constexpr bool in_place =
+				std::is_base_of_v<std::random_access_iterator_tag, typename traits::iterator_category> &&
+				std::is_reference_v<typename traits::reference> &&
+				std::is_same_v<std::remove_cv_t<std::remove_reference_t<typename traits::reference>>, edge_type>;
+
+			if constexpr (!in_place)
+			{
+				scratch_list<edge_type> batch(first, last, get_allocator());
+				add_edges(std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+			}
+			else
+			{
+				const auto count = static_cast<std::size_t>(last - first);
+				const auto threads = detail::thread_count(count);
+				if (threads == 1)
+				{
+					for (; first != last; ++first) {
+						add_edge(*first);
+					}
+					return;
+				}
+
+				const auto groups = detail::group_by_key<vertex_type>(count, threads,
+					[&](std::size_t i) -> const vertex_type& { return first[i].first; }, get_allocator());
+
+				scratch_list<list_type*> lists(groups.size(), nullptr, get_allocator());
+				map.reserve(map.size() + groups.size());
+				for (std::size_t g = 0; g < groups.size(); ++g)
+				{
+					auto& source = map.insert({ first[groups.order[groups.bounds[g]]].first, empty_node() }).first->second;
+					source.list.reserve(source.list.size() + groups.bounds[g + 1] - groups.bounds[g]);
+					lists[g] = &source.list;
+				}
+
+				// lookups only, the map is not touched by anyone else meanwhile
+				scratch_list<node*> targets(count, nullptr, get_allocator());
+				detail::parallel_for(count, threads, [&](std::size_t from, std::size_t to, std::size_t) {
+					for (auto i = from; i != to; ++i)
+					{
+						const auto find = map.find(first[i].second);
+						targets[i] = find != map.end() ? &find->second : nullptr;
+					}
+				});
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					auto target = targets[i];
+					if (!target) {
+						target = &map.insert({ first[i].second, empty_node() }).first->second;
+					}
+					++target->in_degree;
+				}
+				edges += count;
+
+				// every group owns its list and the capacity is already there, the hash
+				// indexes of lists that crossed the threshold are rebuilt afterwards
+				detail::parallel_for(groups.size(), threads, [&](std::size_t from, std::size_t to, std::size_t) {
+					for (auto g = from; g != to; ++g)
+					{
+						for (auto k = groups.bounds[g]; k != groups.bounds[g + 1]; ++k)
+						{
+							auto&& edge = first[groups.order[k]];
+							lists[g]->push_back({ std::forward<decltype(edge)>(edge).second, std::forward<decltype(edge)>(edge).weight });
+						}
+					}
+				});
+
+				for (std::size_t g = 0; g < groups.size(); ++g)
+				{
+					if (lists[g]->size() >= threshold) {
+						reindex(first[groups.order[groups.bounds[g]]].first, *lists[g]);
+					}
+				}
+			}
 		}
 
 		void add_vertex(const vertex_type& vertex) {
-			map.insert({ vertex, list_type(get_allocator()) });
+			map.insert({ vertex, empty_node() });
 		}
 
 		void add_vertex(vertex_type&& vertex) {
-			map.insert({ std::move(vertex), list_type(get_allocator()) });
+			map.insert({ std::move(vertex), empty_node() });
 		}
 
 		void remove_edge(const edge_type& edge)
 		{
-			auto& list = map.find(edge.first)->list;
-			list.erase(std::remove(list.begin(), list.end(), edge.second), list.end());
+			const auto source = map.find(edge.first);
+			const auto removed = unlink(source->second.list, edge.second);
+			if (removed)
+			{
+				unindexed(source->first, source->second.list);
+				map.find(edge.second)->second.in_degree -= removed;
+				edges -= removed;
+			}
 		}
 
+		// the other lists are only scanned while edges into vertex are still unaccounted for
 		void remove_vertex(const vertex_type& vertex)
 		{
-			map.erase(vertex);
-			for (auto&[vert, list] : map) {
-				list.erase(std::remove(list.begin(), list.end(), vertex), list.end());
+			const auto find = map.find(vertex);
+			if (find == map.end()) {
+				return;
+			}
+
+			for (const auto& edge : find->second.list) {
+				--map.find(edge.second)->second.in_degree;
+			}
+			edges -= find->second.list.size();
+
+			auto incoming = find->second.in_degree;
+			hubs.erase(vertex);
+			map.erase(find);
+
+			for (auto it = map.begin(); incoming && it != map.end(); ++it)
+			{
+				const auto removed = unlink(it->second.list, vertex);
+				if (removed) {
+					unindexed(it->first, it->second.list);
+				}
+				incoming -= removed;
+				edges -= removed;
 			}
 		}
 
@@ -115,10 +346,22 @@ namespace lion::graph
 		{
 			size_type result = 0;
 
-			const auto& list = map.find(x)->second;
+			const auto& list = map.find(x)->second.list;
+			if (list.size() >= threshold)
+			{
+				const auto& index = hubs.find(x)->second;
+				const auto find = index.find(y);
+				if (find == index.end()) {
+					return 0;
+				}
+				if (weight) {
+					*weight = list[find->second.last].weight;
+				}
+				return find->second.count;
+			}
 			for (auto&& val : list)
 			{
-				if (val == y) 
+				if (val.second == y)
 				{
 					++result;
 
@@ -130,27 +373,38 @@ namespace lion::graph
 			return result;
 		}
 
+		// lists with at least count entries are hash indexed, changing it rebuilds the indexes
+		void index_threshold(size_type count)
+		{
+			threshold = std::max<size_type>(count, 1);
+			hubs.clear();
+			for (const auto& [key, value] : map)
+			{
+				if (value.list.size() >= threshold) {
+					reindex(key, value.list);
+				}
+			}
+		}
+
+		size_type index_threshold() const noexcept { return threshold; }
+
+		size_type degree(const vertex_type& vertex) const { return map.find(vertex)->second.list.size(); }
+		size_type in_degree(const vertex_type& vertex) const { return map.find(vertex)->second.in_degree; }
+
 		size_type vertex_count() const noexcept {
 			return map.size();
 		}
 
-		size_type edge_count() const noexcept
-		{
-			size_type result = 0;
-			for (auto&&[vert, list] : map) {
-				result += list.size();
-			}
-			return result;
-		}
+		size_type edge_count() const noexcept { return edges; }
 
 		vertex_iterator begin() const noexcept { return vertex_iterator(map.begin()); }
 		vertex_iterator end()   const noexcept { return vertex_iterator(map.end()); }
 
 		edge_iterator begin(const vertex_type& vert) const noexcept {
-			return edge_iterator(map.find(vert)->second.begin());
+			return edge_iterator(map.find(vert)->second.list.begin());
 		}
 		edge_iterator end(const vertex_type& vert) const noexcept {
-			return edge_iterator(map.find(vert)->second.end());
+			return edge_iterator(map.find(vert)->second.list.end());
 		}
 
 		friend bool operator==(const adjacency_list& lhs, const adjacency_list& rhs) {
@@ -160,8 +414,12 @@ namespace lion::graph
 			return !(lhs == rhs);
 		}
 
-		void swap(adjacency_list& rhs) noexcept(noexcept(std::swap(map, rhs.map))) {
+		void swap(adjacency_list& rhs) noexcept(noexcept(std::swap(map, rhs.map)))
+		{
 			std::swap(map, rhs.map);
+			std::swap(edges, rhs.edges);
+			std::swap(hubs, rhs.hubs);
+			std::swap(threshold, rhs.threshold);
 		}
 
 		allocator_type get_allocator() const { return map.get_allocator(); }
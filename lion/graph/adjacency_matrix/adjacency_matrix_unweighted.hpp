@@ -1,20 +1,32 @@
 #ifndef LION_GRAPH_ADJACENCY_MATRIX_UNWEIGHTED_HPP
 #define LION_GRAPH_ADJACENCY_MATRIX_UNWEIGHTED_HPP
 
+#include "../../range.hpp"
+#include "../vertex_interner.hpp"
+#include "../detail/bitops.hpp"
+
 #include <type_traits>
-#include <unordered_map>
 #include <cstddef>
-#include <functional>
+#include <cstdint>
+#include <climits>
 #include <memory>
 #include <utility>
 #include <vector>
 #include <iterator>
+#include <algorithm>
 
 namespace lion::graph
 {
 	template<typename Weighted, typename... Ts>
 	class adjacency_matrix;
 
+	// every row is either a sorted list of column ids or one bit per cell,
+	// whichever is smaller for its degree, so sparse rows cost their degree
+	// to walk and dense ones capacity() / 64 words. the bitmap rows share a
+	// single buffer, stride words apart, and reuse the places of rows that
+	// went sparse again. the matrix holds capacity() columns and grows
+	// geometrically, removed vertices leave an empty row and column behind
+	// until compact()
 	template<typename Vertex, typename Weight, typename Allocator>
 	class adjacency_matrix<std::false_type, Vertex, Weight, Allocator>
 	{
@@ -29,29 +41,50 @@ namespace lion::graph
 		};
 
 	private:
-		using vertices_list = std::unordered_map<
-			vertex_type, 
-			std::size_t, 
-			std::hash<vertex_type>, 
-			std::equal_to<>, 
-			typename std::allocator_traits<allocator_type>::template rebind_alloc<
-				std::pair<const vertex_type, std::size_t>
-			>
+		using vertices_list = vertex_interner<vertex_type, vertex_id, allocator_type>;
+
+		using word_type = std::uint64_t;
+
+		using matrix_type = std::vector<
+			word_type,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<word_type>
 		>;
 
-		using row_type = std::vector<
-			int, 
-			typename std::allocator_traits<allocator_type>::template rebind_alloc<int>
+		using id_list = std::vector<
+			vertex_id,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<vertex_id>
 		>;
 
-		using matrix_type = std::vector<
-			row_type,
-			typename std::allocator_traits<allocator_type>::template rebind_alloc<row_type>
+		using list_type = std::vector<
+			id_list,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<id_list>
 		>;
 
-		std::size_t idx = 0;
+		using degree_list = std::vector<
+			std::size_t,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<std::size_t>
+		>;
+
+		using bit_iterator = detail::set_bit_iterator<vertex_id>;
+		using row_iterator = detail::row_iterator<vertex_id>;
+
+		static constexpr std::size_t no_slot = static_cast<std::size_t>(-1);
+
 		vertices_list vertices;
 		matrix_type matrix;
+		list_type lists;
+		std::size_t rows = 0;
+		std::size_t stride = 0;
+
+		// bitmap row of every id or no_slot, and the bitmap rows not in use
+		degree_list slots;
+		degree_list free_slots;
+		std::size_t slot_count = 0;
+
+		// indexed by id like the rows
+		degree_list out_degrees;
+		degree_list in_degrees;
+		std::size_t edges = 0;
 
 	protected:
 		using size_type		  = typename decltype(matrix)::size_type;
@@ -61,37 +94,232 @@ namespace lion::graph
 		class edge_iterator;
 
 		explicit adjacency_matrix(const allocator_type& alloc = allocator_type{})
-			: vertices(alloc), matrix(alloc)
+			: vertices(alloc), matrix(alloc), lists(alloc), slots(alloc), free_slots(alloc), out_degrees(alloc), in_degrees(alloc)
 		{}
 
 	private:
-		size_type add_vertexi(const vertex_type& vertex)
+		bool dense(size_type index) const noexcept { return slots[index] != no_slot; }
+
+		const word_type* row(size_type index) const noexcept { return matrix.data() + slots[index] * stride; }
+		word_type* row(size_type index) noexcept { return matrix.data() + slots[index] * stride; }
+
+		// a bitmap once the list would take as many bits, a list again below half that
+		bool wants_dense(size_type degree) const noexcept {
+			return degree * sizeof(vertex_id) * CHAR_BIT >= stride * detail::word_bits;
+		}
+
+		bool wants_sparse(size_type degree) const noexcept {
+			return 2 * degree * sizeof(vertex_id) * CHAR_BIT < stride * detail::word_bits;
+		}
+
+		bool test(size_type x, size_type y) const noexcept
+		{
+			if (dense(x)) {
+				return (row(x)[y / detail::word_bits] >> (y % detail::word_bits)) & 1;
+			}
+			return std::binary_search(lists[x].begin(), lists[x].end(), static_cast<vertex_id>(y));
+		}
+
+		void densify(size_type x)
 		{
-			if (auto&&[it, succ] = vertices.insert({ vertex, idx }); succ)
+			if (free_slots.empty())
 			{
-				matrix.push_back(row_type(matrix.size(), 0));
-				for (auto& row : matrix) {
-					row.push_back(0);
+				free_slots.push_back(slot_count++);
+				matrix.resize(slot_count * stride, 0);
+			}
+			slots[x] = free_slots.back();
+			free_slots.pop_back();
+
+			const auto to = row(x);
+			std::fill(to, to + stride, 0);
+			for (const auto y : lists[x]) {
+				to[y / detail::word_bits] |= word_type(1) << (y % detail::word_bits);
+			}
+			id_list(lists.get_allocator()).swap(lists[x]);
+		}
+
+		void sparsify(size_type x)
+		{
+			auto& list = lists[x];
+			list.reserve(out_degrees[x]);
+			for (auto it = bit_iterator(row(x), stride, 0); it != bit_iterator(row(x), stride); ++it) {
+				list.push_back(*it);
+			}
+			free_slots.push_back(slots[x]);
+			slots[x] = no_slot;
+		}
+
+		void link(size_type x, size_type y)
+		{
+			if (dense(x))
+			{
+				auto& word = row(x)[y / detail::word_bits];
+				const auto bit = word_type(1) << (y % detail::word_bits);
+				if (word & bit) {
+					return;
 				}
-				return idx++;
+				word |= bit;
 			}
-			else {
-				return it->second;
+			else
+			{
+				auto& list = lists[x];
+				const auto at = std::lower_bound(list.begin(), list.end(), static_cast<vertex_id>(y));
+				if (at != list.end() && *at == y) {
+					return;
+				}
+				list.insert(at, static_cast<vertex_id>(y));
+			}
+
+			++out_degrees[x];
+			++in_degrees[y];
+			++edges;
+
+			if (!dense(x) && wants_dense(out_degrees[x])) {
+				densify(x);
 			}
 		}
 
+		void unlink(size_type x, size_type y)
+		{
+			if (dense(x))
+			{
+				auto& word = row(x)[y / detail::word_bits];
+				const auto bit = word_type(1) << (y % detail::word_bits);
+				if (!(word & bit)) {
+					return;
+				}
+				word &= ~bit;
+			}
+			else
+			{
+				auto& list = lists[x];
+				const auto at = std::lower_bound(list.begin(), list.end(), static_cast<vertex_id>(y));
+				if (at == list.end() || *at != y) {
+					return;
+				}
+				list.erase(at);
+			}
+
+			--out_degrees[x];
+			--in_degrees[y];
+			--edges;
+
+			if (dense(x) && wants_sparse(out_degrees[x])) {
+				sparsify(x);
+			}
+		}
+
+		// a wider bitmap row costs more, rows that no longer pay for it become lists
+		void reallocate(size_type count)
+		{
+			const auto words = detail::words_for(count);
+
+			matrix_type next(slot_count * words, 0, matrix.get_allocator());
+			for (size_type s = 0; s < slot_count; ++s) {
+				std::copy(matrix.data() + s * stride, matrix.data() + (s + 1) * stride, next.data() + s * words);
+			}
+			matrix.swap(next);
+			rows = count;
+			stride = words;
+
+			lists.resize(count, id_list(lists.get_allocator()));
+			slots.resize(count, no_slot);
+			out_degrees.resize(count, 0);
+			in_degrees.resize(count, 0);
+
+			for (size_type x = 0; x < vertices.bound(); ++x)
+			{
+				if (dense(x) && wants_sparse(out_degrees[x])) {
+					sparsify(x);
+				}
+			}
+		}
+
+		void grow()
+		{
+			if (vertices.bound() > rows) {
+				reallocate(std::max<size_type>(vertices.bound(), rows * 2));
+			}
+		}
+
+		size_type add_vertexi(const vertex_type& vertex)
+		{
+			auto&&[id, succ] = vertices.insert(vertex);
+			if (succ) {
+				grow();
+			}
+			return id;
+		}
+
 		size_type add_vertexi(vertex_type&& vertex)
 		{
-			if (auto&&[it, succ] = vertices.insert({ std::move(vertex), idx }); succ)
+			auto&&[id, succ] = vertices.insert(std::move(vertex));
+			if (succ) {
+				grow();
+			}
+			return id;
+		}
+
+		row_iterator row_begin(size_type index) const noexcept
+		{
+			if (dense(index)) {
+				return row_iterator(bit_iterator(row(index), stride, 0));
+			}
+			return row_iterator(lists[index].data(), lists[index].data());
+		}
+
+		row_iterator row_end(size_type index) const noexcept
+		{
+			if (dense(index)) {
+				return row_iterator(bit_iterator(row(index), stride));
+			}
+			return row_iterator(lists[index].data(), lists[index].data() + lists[index].size());
+		}
+
+		// calls f with every id both x and y have an edge to, in id order
+		template<typename Function>
+		void intersect(size_type x, size_type y, Function f) const
+		{
+			if (dense(x) && dense(y))
 			{
-				matrix.push_back(row_type(matrix.size(), 0));
-				for (auto& row : matrix) {
-					row.push_back(0);
+				const auto rowx = row(x);
+				const auto rowy = row(y);
+				for (std::size_t i = 0; i < stride; ++i)
+				{
+					for (auto word = rowx[i] & rowy[i]; word; word &= word - 1) {
+						f(i * detail::word_bits + detail::countr_zero(word));
+					}
 				}
-				return idx++;
 			}
-			else {
-				return it->second;
+			else if (dense(x) || dense(y))
+			{
+				const auto bits = dense(x) ? x : y;
+				for (const auto id : lists[dense(x) ? y : x])
+				{
+					if (test(bits, id)) {
+						f(id);
+					}
+				}
+			}
+			else
+			{
+				auto lhs = lists[x].begin();
+				auto rhs = lists[y].begin();
+				while (lhs != lists[x].end() && rhs != lists[y].end())
+				{
+					if (*lhs < *rhs) {
+						++lhs;
+					}
+					else if (*rhs < *lhs) {
+						++rhs;
+					}
+					else
+					{
+						f(*lhs);
+						++lhs;
+						++rhs;
+					}
+				}
 			}
 		}
 
@@ -101,7 +329,7 @@ namespace lion::graph
 			const auto idx1 = add_vertexi(edge.first);
 			const auto idx2 = add_vertexi(edge.second);
 
-			matrix[idx1][idx2] = 1;
+			link(idx1, idx2);
 		}
 
 		void add_edge(edge_type&& edge)
@@ -109,7 +337,15 @@ namespace lion::graph
 			const auto idx1 = add_vertexi(std::move(edge.first));
 			const auto idx2 = add_vertexi(std::move(edge.second));
 
-			matrix[idx1][idx2] = 1;
+			link(idx1, idx2);
+		}
+
+		template<typename ForwardIterator>
+		void add_edges(ForwardIterator first, ForwardIterator last)
+		{
+			for (; first != last; ++first) {
+				add_edge(*first);
+			}
 		}
 
 		void add_vertex(const vertex_type& vertex) { add_vertexi(vertex); }
@@ -117,102 +353,193 @@ namespace lion::graph
 
 		void remove_edge(const edge_type& edge)
 		{
-			const auto findx = vertices.find(edge.first);
-			const auto findy = vertices.find(edge.second);
-			matrix[findx->second][findy->second] = 0;
+			const auto findx = vertices.id_of(edge.first);
+			const auto findy = vertices.id_of(edge.second);
+			unlink(findx, findy);
 		}
 
+		// the column is only scanned while edges into vertex are still unaccounted for
 		void remove_vertex(const vertex_type& vertex)
 		{
-			const auto find = vertices.find(vertex);
-			const auto idx = find->second;
+			const auto index = vertices.id_of(vertex);
+
+			for (const auto target : targets(index)) {
+				--in_degrees[target];
+			}
+			edges -= out_degrees[index];
+			out_degrees[index] = 0;
+			if (dense(index))
+			{
+				free_slots.push_back(slots[index]);
+				slots[index] = no_slot;
+			}
+			id_list(lists.get_allocator()).swap(lists[index]);
 
-			matrix.erase(std::next(matrix.begin(), idx));
-			for (auto& row : matrix) {
-				row.erase(std::next(row.begin(), idx));
+			for (size_type r = 0; in_degrees[index] && r < vertices.bound(); ++r) {
+				unlink(r, index);
+			}
+			vertices.erase(index);
+		}
+
+		void reserve(size_type count)
+		{
+			if (count > rows) {
+				reallocate(count);
+			}
+		}
+
+		size_type capacity() const noexcept { return rows; }
+
+		// renumbers the vertices densely, dropping the rows and columns of removed
+		// vertices. remap is monotonic, so lists stay sorted, and every row picks
+		// its encoding again
+		void compact()
+		{
+			const auto bound = vertices.bound();
+			const auto remap = vertices.compact();
+
+			list_type next(rows, id_list(lists.get_allocator()), lists.get_allocator());
+			for (size_type r = 0; r < bound; ++r)
+			{
+				if (remap[r] == vertices_list::npos) {
+					continue;
+				}
+				auto& to = next[remap[r]];
+				to.reserve(out_degrees[r]);
+				for (auto it = row_begin(r); it != row_end(r); ++it) {
+					to.push_back(remap[*it]);
+				}
+				// remap[r] <= r, so the degrees can move down in place
+				out_degrees[remap[r]] = out_degrees[r];
+				in_degrees[remap[r]] = in_degrees[r];
+			}
+			lists.swap(next);
+			matrix.clear();
+			std::fill(slots.begin(), slots.end(), no_slot);
+			free_slots.clear();
+			slot_count = 0;
+
+			std::fill(out_degrees.begin() + vertices.bound(), out_degrees.begin() + bound, 0);
+			std::fill(in_degrees.begin() + vertices.bound(), in_degrees.begin() + bound, 0);
+
+			for (size_type x = 0; x < vertices.bound(); ++x)
+			{
+				if (wants_dense(out_degrees[x])) {
+					densify(x);
+				}
 			}
-			vertices.erase(find);
 		}
 
 		bool has_vertex(const vertex_type& vertex) const
 		{
-			const auto find = matrix.find(vertex);
-			return find != vertices.end();
+			return vertices.contains(vertex);
 		}
 
 		size_type adjacent(const vertex_type& x, const vertex_type& y) const
 		{
-			const auto idxx = vertices.find(x)->second;
-			const auto idxy = vertices.find(y)->second;
+			const auto idxx = vertices.id_of(x);
+			const auto idxy = vertices.id_of(y);
 
-			return size_type(matrix[idxx][idxy]);
+			return size_type(test(idxx, idxy));
 		}
 
-		size_type vertex_count() const noexcept {
-			return vertices.size();
-		}
+		// whether the row of vertex is kept as a bitmap
+		bool dense_row(const vertex_type& vertex) const { return dense(vertices.id_of(vertex)); }
 
-		size_type edge_count() const noexcept
+		// number of vertices both x and y have an edge to, one AND per word
+		// when both rows are bitmaps
+		size_type common_neighbors(const vertex_type& x, const vertex_type& y) const
 		{
+			const auto idxx = vertices.id_of(x);
+			const auto idxy = vertices.id_of(y);
+
 			size_type result = 0;
-			for (auto&& row : matrix)
+			if (dense(idxx) && dense(idxy))
 			{
-				for (int col : row)
-				{
-					if (col) {
-						++result;
-					}
+				const auto rowx = row(idxx);
+				const auto rowy = row(idxy);
+				for (std::size_t i = 0; i < stride; ++i) {
+					result += detail::popcount(rowx[i] & rowy[i]);
 				}
+				return result;
 			}
+			intersect(idxx, idxy, [&result](std::size_t) { ++result; });
 			return result;
 		}
 
-		vertex_iterator begin() const noexcept { return vertex_iterator(vertices.begin()); }
-		vertex_iterator end()   const noexcept { return vertex_iterator(vertices.end()); }
-
-		edge_iterator begin(const vertex_type& vert) const noexcept
+		template<typename OutputIterator>
+		OutputIterator common_neighbors(const vertex_type& x, const vertex_type& y, OutputIterator out) const
 		{
-			const auto find = vertices.find(vert);
-			const auto index = find->second;
+			intersect(vertices.id_of(x), vertices.id_of(y), [&](std::size_t id) {
+				*out++ = vertices.key_of(static_cast<vertex_id>(id));
+			});
+			return out;
+		}
 
-			auto matit = matrix[index].begin();
-			auto verit = vertices.begin();
+		size_type degree(const vertex_type& vertex) const { return out_degrees[vertices.id_of(vertex)]; }
+		size_type in_degree(const vertex_type& vertex) const { return in_degrees[vertices.id_of(vertex)]; }
 
-			while (matit != matrix[index].end() && verit != vertices.end())
-			{
-				if (*matit) {
-					break;
-				}
-				++matit;
-				++verit;
-			}
+		size_type vertex_count() const noexcept {
+			return vertices.size();
+		}
+
+		vertex_id id_of(const vertex_type& vertex) const { return vertices.id_of(vertex); }
+		const vertex_type& key_of(vertex_id id) const { return vertices.key_of(id); }
+		size_type id_bound() const noexcept { return vertices.bound(); }
 
-			return edge_iterator(matit, verit, vertices.end());
+		range<row_iterator> targets(vertex_id id) const noexcept {
+			return { row_begin(id), row_end(id) };
 		}
 
-		edge_iterator end(const vertex_type& vert) const noexcept
-		{
-			const auto find = vertices.find(vert);
-			const auto index = find->second;
+		size_type edge_count() const noexcept { return edges; }
+
+		vertex_iterator begin() const noexcept { return vertex_iterator(vertices.begin()); }
+		vertex_iterator end()   const noexcept { return vertex_iterator(vertices.end()); }
 
-			return edge_iterator(matrix[index].end(), vertices.end(), vertices.end());
+		edge_iterator begin(const vertex_type& vert) const noexcept {
+			return edge_iterator(row_begin(vertices.id_of(vert)), vertices);
 		}
 
-		friend bool operator==(const adjacency_matrix& lhs, const adjacency_matrix& rhs) {
-			return lhs.vertices == rhs.vertices && lhs.matrix == rhs.matrix;
+		edge_iterator end(const vertex_type& vert) const noexcept {
+			return edge_iterator(row_end(vertices.id_of(vert)), vertices);
+		}
+
+		friend bool operator==(const adjacency_matrix& lhs, const adjacency_matrix& rhs)
+		{
+			if (lhs.vertices != rhs.vertices || lhs.edge_count() != rhs.edge_count()) {
+				return false;
+			}
+			for (auto it = lhs.vertices.begin(); it != lhs.vertices.end(); ++it)
+			{
+				const auto x = rhs.vertices.id_of(*it);
+				for (const auto y : lhs.targets(it.id()))
+				{
+					if (!rhs.test(x, rhs.vertices.id_of(lhs.vertices.key_of(y)))) {
+						return false;
+					}
+				}
+			}
+			return true;
 		}
 		friend bool operator!=(const adjacency_matrix& lhs, const adjacency_matrix& rhs) {
 			return !(lhs == rhs);
 		}
 
 		void swap(adjacency_matrix& rhs) noexcept(
-			noexcept(std::swap(idx, rhs.idx)) &&
 			noexcept(std::swap(vertices, rhs.vertices)) &&
 			noexcept(std::swap(matrix, rhs.matrix)))
 		{
-			std::swap(idx, rhs.idx);
 			std::swap(vertices, rhs.vertices);
 			std::swap(matrix, rhs.matrix);
+			std::swap(lists, rhs.lists);
+			std::swap(rows, rhs.rows);
+			std::swap(stride, rhs.stride);
+			std::swap(slots, rhs.slots);
+			std::swap(free_slots, rhs.free_slots);
+			std::swap(slot_count, rhs.slot_count);
+			std::swap(out_degrees, rhs.out_degrees);
+			std::swap(in_degrees, rhs.in_degrees);
+			std::swap(edges, rhs.edges);
 		}
 
 		allocator_type get_allocator() const { return matrix.get_allocator(); }
@@ -1,20 +1,31 @@
 #ifndef LION_GRAPH_ADJACENCY_MATRIX_WEIGHTED_HPP
 #define LION_GRAPH_ADJACENCY_MATRIX_WEIGHTED_HPP
 
+#include "../../range.hpp"
+#include "../vertex_interner.hpp"
+#include "../detail/bitops.hpp"
+
 #include <type_traits>
-#include <unordered_map>
 #include <cstddef>
-#include <functional>
+#include <cstdint>
 #include <memory>
 #include <utility>
 #include <vector>
 #include <iterator>
+#include <algorithm>
 
 namespace lion::graph
 {
 	template<typename Weighted, typename... Ts>
 	class adjacency_matrix;
 
+	// rows are sorted column lists with a parallel weight list, or, once that
+	// gets as large, a bitmap row telling which edges exist plus a row of
+	// capacity() weights. the bitmap rows share one buffer, stride words
+	// apart, and their weight rows another; traversals only read the lists
+	// or bitmaps, weight passes read weight_type arrays. the matrix grows
+	// geometrically and removed vertices leave an empty row and column
+	// behind until compact()
 	template<typename Vertex, typename Weight, typename Allocator>
 	class adjacency_matrix<std::true_type, Vertex, Weight, Allocator>
 	{
@@ -31,42 +42,64 @@ namespace lion::graph
 		};
 
 	private:
-		using vertices_list = std::unordered_map<
-			vertex_type,
-			std::size_t,
-			std::hash<vertex_type>,
-			std::equal_to<>,
-			typename std::allocator_traits<allocator_type>::template rebind_alloc<
-				std::pair<const vertex_type, std::size_t>
-			>
+		using vertices_list = vertex_interner<vertex_type, vertex_id, allocator_type>;
+
+		using word_type = std::uint64_t;
+
+		using matrix_type = std::vector<
+			word_type,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<word_type>
 		>;
 
-		struct edge_type1
-		{
-			int exists;
-			mutable weight_type weight;
+		using weight_list = std::vector<
+			weight_type,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<weight_type>
+		>;
 
-			bool operator==(const edge_type1& rhs) const {
-				return exists == rhs.exists && weight == rhs.weight;
-			}
-			bool operator!=(const edge_type1& rhs) const {
-				return !(*this == rhs);
-			}
-		};
+		using id_list = std::vector<
+			vertex_id,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<vertex_id>
+		>;
 
-		using row_type = std::vector<
-			edge_type1,
-			typename std::allocator_traits<allocator_type>::template rebind_alloc<edge_type1>
+		using list_type = std::vector<
+			id_list,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<id_list>
 		>;
 
-		using matrix_type = std::vector<
-			row_type,
-			typename std::allocator_traits<allocator_type>::template rebind_alloc<row_type>
+		using weight_lists = std::vector<
+			weight_list,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<weight_list>
 		>;
 
-		std::size_t idx = 0;
+		using degree_list = std::vector<
+			std::size_t,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<std::size_t>
+		>;
+
+		using bit_iterator = detail::set_bit_iterator<vertex_id>;
+		using row_iterator = detail::row_iterator<vertex_id>;
+		using weight_iterator = detail::row_value_iterator<const weight_type, vertex_id>;
+
+		static constexpr std::size_t no_slot = static_cast<std::size_t>(-1);
+
 		vertices_list vertices;
 		matrix_type matrix;
+		list_type lists;
+		// weights stay writable through edge iterators of a const matrix
+		mutable weight_list cells;
+		mutable weight_lists list_weights;
+		std::size_t rows = 0;
+		std::size_t stride = 0;
+
+		// bitmap row of every id or no_slot, and the bitmap rows not in use
+		degree_list slots;
+		degree_list free_slots;
+		std::size_t slot_count = 0;
+
+		// indexed by id like the rows
+		degree_list out_degrees;
+		degree_list in_degrees;
+		std::size_t edges = 0;
 
 	protected:
 		using size_type		  = typename decltype(matrix)::size_type;
@@ -76,38 +109,222 @@ namespace lion::graph
 		class edge_iterator;
 
 		explicit adjacency_matrix(const allocator_type& al = allocator_type{})
-			: vertices(al), matrix(al)
+			: vertices(al), matrix(al), lists(al), cells(al), list_weights(al), slots(al), free_slots(al), out_degrees(al), in_degrees(al)
 		{}
 
 	private:
-		size_type add_vertexi(const vertex_type& vertex)
+		bool dense(size_type index) const noexcept { return slots[index] != no_slot; }
+
+		const word_type* row(size_type index) const noexcept { return matrix.data() + slots[index] * stride; }
+		word_type* row(size_type index) noexcept { return matrix.data() + slots[index] * stride; }
+
+		weight_type* weight_row(size_type index) const noexcept { return cells.data() + slots[index] * rows; }
+
+		// where the weights of a row are, indexed by row_iterator::slot()
+		weight_type* row_weights(size_type index) const noexcept {
+			return dense(index) ? weight_row(index) : list_weights[index].data();
+		}
+
+		// a bitmap once the lists would take as many bytes as it and its
+		// weight row, lists again below half that
+		bool wants_dense(size_type degree) const noexcept {
+			return degree * (sizeof(vertex_id) + sizeof(weight_type)) >= stride * sizeof(word_type) + rows * sizeof(weight_type);
+		}
+
+		bool wants_sparse(size_type degree) const noexcept {
+			return 2 * degree * (sizeof(vertex_id) + sizeof(weight_type)) < stride * sizeof(word_type) + rows * sizeof(weight_type);
+		}
+
+		bool test(size_type x, size_type y) const noexcept
 		{
-			if (auto&&[it, succ] = vertices.insert({ vertex, idx }); succ)
+			if (dense(x)) {
+				return (row(x)[y / detail::word_bits] >> (y % detail::word_bits)) & 1;
+			}
+			return std::binary_search(lists[x].begin(), lists[x].end(), static_cast<vertex_id>(y));
+		}
+
+		// the weight of the edge from x to y, nullptr when there is none
+		weight_type* weight_at(size_type x, size_type y) const noexcept
+		{
+			if (dense(x)) {
+				return test(x, y) ? weight_row(x) + y : nullptr;
+			}
+			const auto& list = lists[x];
+			const auto at = std::lower_bound(list.begin(), list.end(), static_cast<vertex_id>(y));
+			return at != list.end() && *at == y ? list_weights[x].data() + (at - list.begin()) : nullptr;
+		}
+
+		void densify(size_type x)
+		{
+			if (free_slots.empty())
 			{
-				matrix.push_back(row_type(matrix.size()));
-				for (auto& row : matrix) {
-					row.push_back({ 0 });
+				free_slots.push_back(slot_count++);
+				matrix.resize(slot_count * stride, 0);
+				cells.resize(slot_count * rows);
+			}
+			slots[x] = free_slots.back();
+			free_slots.pop_back();
+
+			const auto to = row(x);
+			const auto weights = weight_row(x);
+			std::fill(to, to + stride, 0);
+			for (std::size_t i = 0; i < lists[x].size(); ++i)
+			{
+				const auto y = lists[x][i];
+				to[y / detail::word_bits] |= word_type(1) << (y % detail::word_bits);
+				weights[y] = std::move(list_weights[x][i]);
+			}
+			id_list(lists.get_allocator()).swap(lists[x]);
+			weight_list(cells.get_allocator()).swap(list_weights[x]);
+		}
+
+		void sparsify(size_type x)
+		{
+			auto& list = lists[x];
+			auto& weights = list_weights[x];
+			list.reserve(out_degrees[x]);
+			weights.reserve(out_degrees[x]);
+			for (auto it = bit_iterator(row(x), stride, 0); it != bit_iterator(row(x), stride); ++it)
+			{
+				list.push_back(*it);
+				weights.push_back(std::move(weight_row(x)[*it]));
+			}
+			free_slots.push_back(slots[x]);
+			slots[x] = no_slot;
+		}
+
+		// a wider bitmap row costs more, rows that no longer pay for it become lists
+		void reallocate(size_type count)
+		{
+			const auto words = detail::words_for(count);
+
+			matrix_type next(slot_count * words, 0, matrix.get_allocator());
+			weight_list next_weights(slot_count * count, weight_type{}, cells.get_allocator());
+			for (size_type s = 0; s < slot_count; ++s)
+			{
+				std::copy(matrix.data() + s * stride, matrix.data() + (s + 1) * stride, next.data() + s * words);
+				std::move(cells.data() + s * rows, cells.data() + (s + 1) * rows, next_weights.data() + s * count);
+			}
+			matrix.swap(next);
+			cells.swap(next_weights);
+			rows = count;
+			stride = words;
+
+			lists.resize(count, id_list(lists.get_allocator()));
+			list_weights.resize(count, weight_list(cells.get_allocator()));
+			slots.resize(count, no_slot);
+			out_degrees.resize(count, 0);
+			in_degrees.resize(count, 0);
+
+			for (size_type x = 0; x < vertices.bound(); ++x)
+			{
+				if (dense(x) && wants_sparse(out_degrees[x])) {
+					sparsify(x);
 				}
-				return idx++;
 			}
-			else {
-				return it->second;
+		}
+
+		void grow()
+		{
+			if (vertices.bound() > rows) {
+				reallocate(std::max<size_type>(vertices.bound(), rows * 2));
 			}
 		}
 
-		size_type add_vertexi(vertex_type&& vertex)
+		template<typename W>
+		void link(size_type x, size_type y, W&& weight)
 		{
-			if (auto&&[it, succ] = vertices.insert({ std::move(vertex), idx }); succ)
+			if (const auto current = weight_at(x, y))
 			{
-				matrix.push_back(row_type(matrix.size()));
-				for (auto& row : matrix) {
-					row.push_back({ 0 });
+				*current = std::forward<W>(weight);
+				return;
+			}
+
+			if (dense(x))
+			{
+				row(x)[y / detail::word_bits] |= word_type(1) << (y % detail::word_bits);
+				weight_row(x)[y] = std::forward<W>(weight);
+			}
+			else
+			{
+				auto& list = lists[x];
+				const auto at = std::lower_bound(list.begin(), list.end(), static_cast<vertex_id>(y));
+				list_weights[x].insert(list_weights[x].begin() + (at - list.begin()), std::forward<W>(weight));
+				list.insert(at, static_cast<vertex_id>(y));
+			}
+
+			++out_degrees[x];
+			++in_degrees[y];
+			++edges;
+
+			if (!dense(x) && wants_dense(out_degrees[x])) {
+				densify(x);
+			}
+		}
+
+		void unlink(size_type x, size_type y)
+		{
+			if (dense(x))
+			{
+				auto& word = row(x)[y / detail::word_bits];
+				const auto bit = word_type(1) << (y % detail::word_bits);
+				if (!(word & bit)) {
+					return;
 				}
-				return idx++;
+				word &= ~bit;
 			}
-			else {
-				return it->second;
+			else
+			{
+				auto& list = lists[x];
+				const auto at = std::lower_bound(list.begin(), list.end(), static_cast<vertex_id>(y));
+				if (at == list.end() || *at != y) {
+					return;
+				}
+				list_weights[x].erase(list_weights[x].begin() + (at - list.begin()));
+				list.erase(at);
 			}
+
+			--out_degrees[x];
+			--in_degrees[y];
+			--edges;
+
+			if (dense(x) && wants_sparse(out_degrees[x])) {
+				sparsify(x);
+			}
+		}
+
+		size_type add_vertexi(const vertex_type& vertex)
+		{
+			auto&&[id, succ] = vertices.insert(vertex);
+			if (succ) {
+				grow();
+			}
+			return id;
+		}
+
+		size_type add_vertexi(vertex_type&& vertex)
+		{
+			auto&&[id, succ] = vertices.insert(std::move(vertex));
+			if (succ) {
+				grow();
+			}
+			return id;
+		}
+
+		row_iterator row_begin(size_type index) const noexcept
+		{
+			if (dense(index)) {
+				return row_iterator(bit_iterator(row(index), stride, 0));
+			}
+			return row_iterator(lists[index].data(), lists[index].data());
+		}
+
+		row_iterator row_end(size_type index) const noexcept
+		{
+			if (dense(index)) {
+				return row_iterator(bit_iterator(row(index), stride));
+			}
+			return row_iterator(lists[index].data(), lists[index].data() + lists[index].size());
 		}
 
 	public:
@@ -116,7 +333,7 @@ namespace lion::graph
 			const auto idx1 = add_vertexi(edge.first);
 			const auto idx2 = add_vertexi(edge.second);
 
-			matrix[idx1][idx2] = { 1, edge.weight };
+			link(idx1, idx2, edge.weight);
 		}
 
 		void add_edge(edge_type&& edge)
@@ -124,7 +341,15 @@ namespace lion::graph
 			const auto idx1 = add_vertexi(std::move(edge.first));
 			const auto idx2 = add_vertexi(std::move(edge.second));
 
-			matrix[idx1][idx2] = { 1, std::move(edge.weight) };
+			link(idx1, idx2, std::move(edge.weight));
+		}
+
+		template<typename ForwardIterator>
+		void add_edges(ForwardIterator first, ForwardIterator last)
+		{
+			for (; first != last; ++first) {
+				add_edge(*first);
+			}
 		}
 
 		void add_vertex(const vertex_type& vertex) {
@@ -137,113 +362,191 @@ namespace lion::graph
 
 		void remove_edge(const edge_type& edge)
 		{
-			const auto findx = vertices.find(edge.first);
-			const auto findy = vertices.find(edge.second);
-			
-			matrix[findx->second][findy->second].exists = 0;
+			const auto findx = vertices.id_of(edge.first);
+			const auto findy = vertices.id_of(edge.second);
+
+			unlink(findx, findy);
 		}
 
+		// the column is only scanned while edges into vertex are still unaccounted for
 		void remove_vertex(const vertex_type& vertex)
 		{
-			const auto find = vertices.find(vertex);
-			const auto index = find->second;
+			const auto index = vertices.id_of(vertex);
 
-			matrix.erase(std::next(matrix.begin(), index));
+			for (const auto target : targets(index)) {
+				--in_degrees[target];
+			}
+			edges -= out_degrees[index];
+			out_degrees[index] = 0;
+			if (dense(index))
+			{
+				free_slots.push_back(slots[index]);
+				slots[index] = no_slot;
+			}
+			id_list(lists.get_allocator()).swap(lists[index]);
+			weight_list(cells.get_allocator()).swap(list_weights[index]);
 
-			for (auto& row : matrix) {
-				row.erase(std::next(row.begin(), index));
+			for (size_type r = 0; in_degrees[index] && r < vertices.bound(); ++r) {
+				unlink(r, index);
 			}
-			for (auto it = std::next(find); it != vertices.end(); ++it) {
-				--it->second;
+			vertices.erase(index);
+		}
+
+		void reserve(size_type count)
+		{
+			if (count > rows) {
+				reallocate(count);
 			}
-			vertices.erase(find);
+		}
+
+		size_type capacity() const noexcept { return rows; }
+
+		// renumbers the vertices densely, dropping the rows and columns of removed
+		// vertices. remap is monotonic, so lists stay sorted, and every row picks
+		// its encoding again
+		void compact()
+		{
+			const auto bound = vertices.bound();
+			const auto remap = vertices.compact();
 
-			--idx;
+			list_type next(rows, id_list(lists.get_allocator()), lists.get_allocator());
+			weight_lists next_weights(rows, weight_list(cells.get_allocator()), cells.get_allocator());
+			for (size_type r = 0; r < bound; ++r)
+			{
+				if (remap[r] == vertices_list::npos) {
+					continue;
+				}
+				auto& to = next[remap[r]];
+				auto& to_weights = next_weights[remap[r]];
+				to.reserve(out_degrees[r]);
+				to_weights.reserve(out_degrees[r]);
+
+				const auto weights = row_weights(r);
+				for (auto it = row_begin(r); it != row_end(r); ++it)
+				{
+					to.push_back(remap[*it]);
+					to_weights.push_back(std::move(weights[it.slot()]));
+				}
+				// remap[r] <= r, so the degrees can move down in place
+				out_degrees[remap[r]] = out_degrees[r];
+				in_degrees[remap[r]] = in_degrees[r];
+			}
+			lists.swap(next);
+			list_weights.swap(next_weights);
+			matrix.clear();
+			cells.clear();
+			std::fill(slots.begin(), slots.end(), no_slot);
+			free_slots.clear();
+			slot_count = 0;
+
+			std::fill(out_degrees.begin() + vertices.bound(), out_degrees.begin() + bound, 0);
+			std::fill(in_degrees.begin() + vertices.bound(), in_degrees.begin() + bound, 0);
+
+			for (size_type x = 0; x < vertices.bound(); ++x)
+			{
+				if (wants_dense(out_degrees[x])) {
+					densify(x);
+				}
+			}
 		}
 
 		bool has_vertex(const vertex_type& vertex) const
 		{
-			const auto find = vertices.find(vertex);
-			return find != vertices.end();
+			return vertices.contains(vertex);
 		}
 
 		size_type adjacent(const vertex_type& x, const vertex_type& y, weight_type* weight) const
 		{
-			const auto findx = vertices.find(x);
-			const auto findy = vertices.find(y);
+			const auto findx = vertices.id_of(x);
+			const auto findy = vertices.id_of(y);
 
-			const auto res = matrix[findx->second][findy->second];
-			if (weight) {
-				*weight = res.weight;
+			const auto current = weight_at(findx, findy);
+			if (weight && current) {
+				*weight = *current;
 			}
-			return res.exists;
+			return size_type(current != nullptr);
 		}
 
+		// whether the row of vertex is kept as a bitmap
+		bool dense_row(const vertex_type& vertex) const { return dense(vertices.id_of(vertex)); }
+
+		size_type degree(const vertex_type& vertex) const { return out_degrees[vertices.id_of(vertex)]; }
+		size_type in_degree(const vertex_type& vertex) const { return in_degrees[vertices.id_of(vertex)]; }
+
 		size_type vertex_count() const noexcept {
 			return vertices.size();
 		}
 
-		size_type edge_count() const noexcept
-		{
-			size_type result = 0;
-			for (auto&& row : matrix)
-			{
-				for (auto&&[i, w] : row)
-				{
-					if (i) {
-						++result;
-					}
-				}
-			}
-			return result;
+		vertex_id id_of(const vertex_type& vertex) const { return vertices.id_of(vertex); }
+		const vertex_type& key_of(vertex_id id) const { return vertices.key_of(id); }
+		size_type id_bound() const noexcept { return vertices.bound(); }
+
+		range<row_iterator> targets(vertex_id id) const noexcept {
+			return { row_begin(id), row_end(id) };
 		}
 
+		// parallel to targets(id)
+		range<weight_iterator> weights(vertex_id id) const noexcept {
+			return { weight_iterator(row_begin(id), row_weights(id)), weight_iterator(row_end(id), row_weights(id)) };
+		}
+
+		size_type edge_count() const noexcept { return edges; }
+
 		vertex_iterator begin() const noexcept { return vertex_iterator(vertices.begin()); }
 		vertex_iterator end()   const noexcept { return vertex_iterator(vertices.end()); }
 
 		edge_iterator begin(const vertex_type& vert) const noexcept
 		{
-			const auto find = vertices.find(vert);
-			const auto index = find->second;
-
-			auto matit = matrix[index].begin();
-			auto verit = vertices.begin();
-
-			while (matit != matrix[index].end() && verit != vertices.end())
-			{
-				if (matit->exists) {
-					break;
-				}
-				++matit;
-				++verit;
-			}
-
-			return edge_iterator(matit, verit, vertices.end());
+			const auto index = vertices.id_of(vert);
+			return edge_iterator(row_begin(index), row_weights(index), vertices);
 		}
 
 		edge_iterator end(const vertex_type& vert) const noexcept
 		{
-			const auto find = vertices.find(vert);
-			const auto index = find->second;
-
-			return edge_iterator(matrix[index].end(), vertices.end(), vertices.end());
+			const auto index = vertices.id_of(vert);
+			return edge_iterator(row_end(index), row_weights(index), vertices);
 		}
 
-		friend bool operator==(const adjacency_matrix& lhs, const adjacency_matrix& rhs) {
-			return lhs.vertices == rhs.vertices && lhs.matrix == rhs.matrix;
+		friend bool operator==(const adjacency_matrix& lhs, const adjacency_matrix& rhs)
+		{
+			if (lhs.vertices != rhs.vertices || lhs.edge_count() != rhs.edge_count()) {
+				return false;
+			}
+			for (auto it = lhs.vertices.begin(); it != lhs.vertices.end(); ++it)
+			{
+				const auto x = rhs.vertices.id_of(*it);
+				for (const auto y : lhs.targets(it.id()))
+				{
+					const auto other = rhs.weight_at(x, rhs.vertices.id_of(lhs.vertices.key_of(y)));
+					if (!other || !(*lhs.weight_at(it.id(), y) == *other)) {
+						return false;
+					}
+				}
+			}
+			return true;
 		}
 		friend bool operator!=(const adjacency_matrix& lhs, const adjacency_matrix& rhs) {
 			return !(lhs == rhs);
 		}
 
 		void swap(adjacency_matrix& rhs) noexcept(
-			noexcept(std::swap(idx, rhs.idx)) &&
 			noexcept(std::swap(vertices, rhs.vertices)) &&
-			noexcept(std::swap(matrix, rhs.matrix))) 
+			noexcept(std::swap(matrix, rhs.matrix)) &&
+			noexcept(std::swap(cells, rhs.cells)))
 		{
-			std::swap(idx, rhs.idx);
 			std::swap(vertices, rhs.vertices);
 			std::swap(matrix, rhs.matrix);
+			std::swap(lists, rhs.lists);
+			std::swap(cells, rhs.cells);
+			std::swap(list_weights, rhs.list_weights);
+			std::swap(rows, rhs.rows);
+			std::swap(stride, rhs.stride);
+			std::swap(slots, rhs.slots);
+			std::swap(free_slots, rhs.free_slots);
+			std::swap(slot_count, rhs.slot_count);
+			std::swap(out_degrees, rhs.out_degrees);
+			std::swap(in_degrees, rhs.in_degrees);
+			std::swap(edges, rhs.edges);
 		}
 
 		allocator_type get_allocator() const { return matrix.get_allocator(); }
@@ -7,6 +7,7 @@
 #include <type_traits>
 #include <iterator>
 #include <memory>
+#include <cstddef>
 
 namespace lion::graph
 {
@@ -20,19 +21,18 @@ namespace lion::graph
 
 		using matrix = adjacency_matrix<std::false_type, Vertex, Weight, Allocator>;
 
-		typename matrix::row_type::const_iterator current;
-		typename matrix::vertices_list::const_iterator vertex;
-		typename matrix::vertices_list::const_iterator end;
+		typename matrix::row_iterator current;
+		const typename matrix::vertices_list* vertices = nullptr;
 
-		edge_iterator(decltype(current) curr, decltype(vertex) vert, decltype(end) last)
-			: current(curr), vertex(vert), end(last)
+		edge_iterator(typename matrix::row_iterator curr, const typename matrix::vertices_list& verts)
+			: current(curr), vertices(std::addressof(verts))
 		{}
 
 	public:
 		using value_type		= typename matrix::vertex_type;
 		using reference			= const value_type&;
 		using pointer			= const value_type*;
-		using difference_type	= typename  decltype(vertex)::difference_type;
+		using difference_type	= std::ptrdiff_t;
 		using iterator_category = std::forward_iterator_tag;
 
 		edge_iterator() = default;
@@ -41,35 +41,29 @@ namespace lion::graph
 
 		edge_iterator& operator++()
 		{
-			++vertex;
 			++current;
-			if (vertex != end) 
-			{
-				if (!*current) {
-					++*this;
-				}
-			}
 			return *this;
 		}
 
 		edge_iterator operator++(int)
 		{
-			edge_iterator temp(current);
-			++*this;
+			edge_iterator temp(*this);
+			++current;
 			return temp;
 		}
 
-		reference operator*() const { return vertex->first; }
-		pointer operator->()  const { return std::addressof(vertex->first); }
+		reference operator*() const { return vertices->key_of(*current); }
+		pointer operator->()  const { return std::addressof(vertices->key_of(*current)); }
 
 		friend bool operator==(const edge_iterator& lhs, const edge_iterator& rhs) {
-			return lhs.current == rhs.current && lhs.vertex == rhs.vertex;
+			return lhs.current == rhs.current;
 		}
 		friend bool operator!=(const edge_iterator& lhs, const edge_iterator& rhs) {
 			return !(lhs == rhs);
 		}
 	};
 
+	// weighted
 	template<typename Vertex, typename Weight, typename Allocator>
 	class adjacency_matrix<std::true_type, Vertex, Weight, Allocator>::edge_iterator
 	{
@@ -77,86 +71,34 @@ namespace lion::graph
 		template<typename Weighted, typename... Ts>
 		friend class adjacency_matrix;
 
-		using matrix		  = adjacency_matrix<std::true_type, Vertex, Weight, Allocator>;
-		using vert_iterator	  = typename matrix::vertices_list::const_iterator;
-		using weight_iterator = typename matrix::row_type::const_iterator;
+		using matrix = adjacency_matrix<std::true_type, Vertex, Weight, Allocator>;
 
-		vert_iterator end;
+		typename matrix::row_iterator current;
+		// the weights of the row, indexed by current.slot()
+		typename matrix::weight_type* weights = nullptr;
+		const typename matrix::vertices_list* vertices = nullptr;
 
-		edge_iterator(weight_iterator curr, vert_iterator vert, vert_iterator last)
-			: end(last), value{ curr, vert }
+		edge_iterator(typename matrix::row_iterator curr, typename matrix::weight_type* w, const typename matrix::vertices_list& verts)
+			: current(curr), weights(w), vertices(std::addressof(verts))
 		{}
 
-		struct helper1
-		{
-		private:
-			friend class matrix::edge_iterator;
-
-			vert_iterator iter;
-			helper1(vert_iterator it) : iter(it) {}
-
-			bool operator==(const helper1& rhs) const { return iter == rhs.iter; }
-
-		public:
-			operator const typename matrix::vertex_type&() const { return iter->first; }
-		};
-
-		struct helper2
-		{
-		private:
-			friend class matrix::edge_iterator;
-
-			weight_iterator iter;
-			helper2(weight_iterator it) : iter(it) {}
-
-			bool operator==(const helper2& rhs) const { return iter == rhs.iter; }
-
-		public:
-			operator       typename matrix::weight_type&()       { return iter->weight; }
-			operator const typename matrix::weight_type&() const { return iter->weight; }
-
-			helper2& operator=(const typename matrix::weight_type& val)
-			{
-				iter->weight = val;
-				return *this;
-			}
-
-			helper2& operator=(typename matrix::weight_type&& val)
-			{
-				iter->weight = std::move(val);
-				return *this;
-			}
-		};
-
 	public:
 		struct value_type
 		{
-		private:
-			friend class matrix::edge_iterator;
-
-			bool operator==(const value_type& rhs) const {
-				return second == rhs.second && weight == rhs.weight;
-			}
+			const typename matrix::vertex_type& second;
+			typename matrix::weight_type& weight;
 
-			value_type(weight_iterator curr, vert_iterator vert)
-				: second(vert), weight(curr)
-			{}
-
-		public:
-			helper1 second;
-			mutable helper2 weight;
-
-			operator       typename matrix::vertex_type&()       { return second; }
 			operator const typename matrix::vertex_type&() const { return second; }
 		};
 
-	private:
-		value_type value;
+		struct pointer
+		{
+			value_type value;
+			const value_type* operator->() const { return std::addressof(value); }
+		};
 
-	public:
-		using reference			= const value_type&;
-		using pointer			= const value_type*;
-		using difference_type   = typename vert_iterator::difference_type;
+		using reference			= value_type;
+		using difference_type   = std::ptrdiff_t;
 		using iterator_category = std::forward_iterator_tag;
 
 		edge_iterator() = default;
@@ -165,14 +107,7 @@ namespace lion::graph
 
 		edge_iterator& operator++()
 		{
-			++value.second.iter;
-			++value.weight.iter;
-			if (value.second.iter != end)
-			{
-				if (!value.weight.iter->exists) {
-					++*this;
-				}
-			}
+			++current;
 			return *this;
 		}
 
@@ -183,10 +118,10 @@ namespace lion::graph
 			return temp;
 		}
 
-		reference operator*() const { return value; }
-		pointer operator->()  const { return std::addressof(operator*()); }
+		reference operator*() const { return { vertices->key_of(*current), weights[current.slot()] }; }
+		pointer operator->()  const { return { operator*() }; }
 
-		bool operator==(const edge_iterator& rhs) const { return value == rhs.value; }
+		bool operator==(const edge_iterator& rhs) const { return current == rhs.current; }
 		bool operator!=(const edge_iterator& rhs) const { return !(*this == rhs); }
 	};
 }
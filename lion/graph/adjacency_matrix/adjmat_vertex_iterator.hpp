@@ -50,8 +50,8 @@ namespace lion::graph
 			return temp;
 		}
 
-		reference operator*() const { return current->first; }
-		pointer operator->()  const { return std::addressof(current->first); }
+		reference operator*() const { return *current; }
+		pointer operator->()  const { return std::addressof(*current); }
 
 		friend bool operator==(const vertex_iterator& lhs, const vertex_iterator& rhs) {
 			return lhs.current == rhs.current;
@@ -101,8 +101,8 @@ namespace lion::graph
 			return temp;
 		}
 
-		reference operator*() const { return current->first; }
-		pointer operator->()  const { return std::addressof(current->first); }
+		reference operator*() const { return *current; }
+		pointer operator->()  const { return std::addressof(*current); }
 
 		friend bool operator==(const vertex_iterator& lhs, const vertex_iterator& rhs) {
 			return lhs.current == rhs.current;
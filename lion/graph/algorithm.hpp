@@ -3,5 +3,16 @@
 
 #include "algorithm/dfs_bfs.hpp"
 #include "algorithm/topological_sort.hpp"
+#include "algorithm/pagerank.hpp"
+#include "algorithm/triangles.hpp"
+#include "algorithm/reorder.hpp"
+#include "algorithm/sharded_bfs.hpp"
+#include "algorithm/parallel_bfs.hpp"
+#include "algorithm/multi_source_bfs.hpp"
+#include "algorithm/dijkstra.hpp"
+#include "algorithm/delta_stepping.hpp"
+#include "algorithm/bidirectional_dijkstra.hpp"
+#include "algorithm/astar.hpp"
+#include "algorithm/contraction_hierarchy.hpp"
 
 #endif
@@ -0,0 +1,153 @@
+#ifndef LION_GRAPH_ASTAR_HPP
+#define LION_GRAPH_ASTAR_HPP
+
+#include "dijkstra.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace lion::graph
+{
+	// point to point shortest paths guided by heuristic(vertex, target), a
+	// lower bound on the distance left such as the straight line between two
+	// coordinates. ids are settled by distance plus estimate, so the search
+	// leans towards the target and stops when it settles it. the heuristic
+	// has to be consistent, never dropping by more than an edge's weight along
+	// that edge, for the first path to the target to be the shortest; a
+	// heuristic of zero makes this dijkstra. estimates are computed once per
+	// id and query, and like shortest_paths a query resets only what the
+	// previous one touched
+	template<
+		typename Graph,
+		typename Heuristic,
+		template<typename, typename, typename> typename Heap = binary_heap,
+		typename WeightMap = graph_weights<Graph>,
+		typename Allocator = typename Graph::allocator_type
+	>
+	class astar_paths
+	{
+		static_assert(is_indexed_graph_v<Graph>, "astar_paths needs an indexed graph, freeze the graph into a csr first");
+
+	public:
+		using graph_type	= Graph;
+		using vertex_type	= typename Graph::vertex_type;
+		using id_type		= decltype(std::declval<const Graph&>().id_of(std::declval<const vertex_type&>()));
+		using distance_type = typename detail::distance_of<Graph, WeightMap>::type;
+
+		static constexpr distance_type unreached = std::numeric_limits<distance_type>::max();
+		static constexpr id_type no_parent = static_cast<id_type>(-1);
+
+	private:
+		template<typename T>
+		using list_type = std::vector<T, typename std::allocator_traits<Allocator>::template rebind_alloc<T>>;
+
+		const Graph* graph;
+		Heuristic heuristic;
+		WeightMap weights;
+		detail::search_state<id_type, distance_type, Heap, Allocator> state;
+
+		// heuristic per touched id, unreached until asked for
+		list_type<distance_type> estimates;
+
+		id_type goal = no_parent;
+		std::size_t settles = 0;
+
+		distance_type estimate(id_type id)
+		{
+			auto& known = estimates[id];
+			if (known == unreached) {
+				known = static_cast<distance_type>(std::invoke(heuristic, graph->key_of(id), graph->key_of(goal)));
+			}
+			return known;
+		}
+
+	public:
+		astar_paths(const Graph& g, Heuristic h, const Allocator& alloc = Allocator{})
+			: astar_paths(g, std::move(h), WeightMap(g), alloc)
+		{}
+
+		astar_paths(const Graph& g, Heuristic h, WeightMap map, const Allocator& alloc = Allocator{})
+			: graph(std::addressof(g)), heuristic(std::move(h)), weights(std::move(map)), state(alloc), estimates(alloc)
+		{}
+
+		// true if target is reachable from origin, distance() and path() then
+		// describe a shortest path between them
+		bool run(const vertex_type& origin, const vertex_type& target)
+		{
+			const std::size_t bound = graph->id_bound();
+			if (estimates.size() != bound) {
+				estimates.assign(bound, unreached);
+			}
+			else
+			{
+				for (const auto id : state.touched) {
+					estimates[id] = unreached;
+				}
+			}
+			state.prepare(bound);
+			goal = no_parent;
+			settles = 0;
+
+			const std::size_t from = graph->id_of(origin);
+			const std::size_t to = graph->id_of(target);
+			if (from >= bound || to >= bound) {
+				return false;
+			}
+
+			goal = static_cast<id_type>(to);
+			state.start(static_cast<id_type>(from), estimate(static_cast<id_type>(from)));
+
+			for (;;)
+			{
+				const id_type id = state.next().second;
+				if (id == no_parent) {
+					return false;
+				}
+				state.settled[id] = 1;
+				++settles;
+
+				if (id == goal) {
+					return true;
+				}
+
+				const distance_type length = state.distances[id];
+				detail::for_each_weighted<distance_type>(*graph, weights, id, [&](id_type target, distance_type weight) {
+					if (!state.settled[target] && state.lower(target, id, length + weight)) {
+						state.heap.push(target, length + weight + estimate(target));
+					}
+				});
+			}
+		}
+
+		// the length of the path the last query found, unreached if none
+		distance_type distance() const noexcept {
+			return goal != no_parent && state.settled[goal] ? state.distances[goal] : unreached;
+		}
+
+		// ids the last query settled
+		std::size_t settled() const noexcept { return settles; }
+
+		// writes the vertices on the path the last query found, origin and
+		// target included, or nothing if it found none
+		template<typename OutputIterator>
+		OutputIterator path(OutputIterator out) const
+		{
+			if (goal == no_parent || !state.settled[goal]) {
+				return out;
+			}
+
+			list_type<id_type> ids(estimates.get_allocator());
+			state.trace(goal, ids);
+			for (const auto id : ids) {
+				*out++ = graph->key_of(id);
+			}
+			return out;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,222 @@
+#ifndef LION_GRAPH_BIDIRECTIONAL_DIJKSTRA_HPP
+#define LION_GRAPH_BIDIRECTIONAL_DIJKSTRA_HPP
+
+#include "dijkstra.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace lion::graph
+{
+	// point to point shortest paths searched from both ends at once, each
+	// step settles the side with the nearer frontier and the search stops
+	// once the two frontiers together are no shorter than the best meeting
+	// found. undirected graphs search backwards along their own rows, directed
+	// ones along a reversed copy built once by the constructor, so the
+	// workspace has to be rebuilt when a directed graph changes. like
+	// shortest_paths, a query resets only the ids the previous one touched
+	template<
+		typename Graph,
+		template<typename, typename, typename> typename Heap = binary_heap,
+		typename WeightMap = graph_weights<Graph>,
+		typename Allocator = typename Graph::allocator_type
+	>
+	class bidirectional_paths
+	{
+		static_assert(is_indexed_graph_v<Graph>, "bidirectional_paths needs an indexed graph, freeze the graph into a csr first");
+
+	public:
+		using graph_type	= Graph;
+		using vertex_type	= typename Graph::vertex_type;
+		using id_type		= decltype(std::declval<const Graph&>().id_of(std::declval<const vertex_type&>()));
+		using distance_type = typename detail::distance_of<Graph, WeightMap>::type;
+
+		static constexpr distance_type unreached = std::numeric_limits<distance_type>::max();
+		static constexpr id_type no_parent = static_cast<id_type>(-1);
+
+	private:
+		template<typename T>
+		using list_type = std::vector<T, typename std::allocator_traits<Allocator>::template rebind_alloc<T>>;
+
+		using state_type = detail::search_state<id_type, distance_type, Heap, Allocator>;
+
+		static constexpr bool symmetric = graph_traits<Graph>::is_graph && !graph_traits<Graph>::is_directed;
+
+		const Graph* graph;
+		WeightMap weights;
+
+		// the reversed rows of a directed graph, sources[offsets[id]..offsets[id + 1]]
+		// reach id with lengths parallel to them
+		list_type<std::size_t> offsets;
+		list_type<id_type> sources;
+		list_type<distance_type> lengths;
+
+		state_type forward;
+		state_type backward;
+
+		distance_type best = unreached;
+		id_type meet = no_parent;
+		std::size_t settles = 0;
+
+		void reverse()
+		{
+			const std::size_t bound = graph->id_bound();
+			offsets.assign(bound + 1, 0);
+			for (std::size_t id = 0; id < bound; ++id)
+			{
+				for (const id_type target : graph->targets(static_cast<id_type>(id))) {
+					++offsets[static_cast<std::size_t>(target) + 1];
+				}
+			}
+			for (std::size_t id = 0; id < bound; ++id) {
+				offsets[id + 1] += offsets[id];
+			}
+
+			sources.resize(offsets[bound]);
+			lengths.resize(offsets[bound]);
+			list_type<std::size_t> cursors(offsets.begin(), offsets.end() - 1, offsets.get_allocator());
+			for (std::size_t id = 0; id < bound; ++id)
+			{
+				detail::for_each_weighted<distance_type>(*graph, weights, static_cast<id_type>(id), [&](id_type target, distance_type weight) {
+					const auto position = cursors[target]++;
+					sources[position] = static_cast<id_type>(id);
+					lengths[position] = weight;
+				});
+			}
+		}
+
+		template<typename Function>
+		void for_each_backward(id_type id, Function&& f) const
+		{
+			if constexpr (symmetric) {
+				detail::for_each_weighted<distance_type>(*graph, weights, id, f);
+			}
+			else
+			{
+				for (auto position = offsets[id]; position != offsets[id + 1]; ++position) {
+					f(sources[position], lengths[position]);
+				}
+			}
+		}
+
+		// settles id on one side and offers every edge it relaxes as a meeting
+		template<typename Edges>
+		void settle(state_type& self, const state_type& other, id_type id, distance_type length, Edges&& edges)
+		{
+			self.settled[id] = 1;
+			++settles;
+
+			edges(id, [&](id_type target, distance_type weight) {
+				const distance_type through = length + weight;
+				if (!self.settled[target] && self.lower(target, id, through)) {
+					self.heap.push(target, through);
+				}
+				if (other.distances[target] != unreached && through + other.distances[target] < best)
+				{
+					best = through + other.distances[target];
+					meet = target;
+				}
+			});
+		}
+
+	public:
+		explicit bidirectional_paths(const Graph& g, const Allocator& alloc = Allocator{})
+			: bidirectional_paths(g, WeightMap(g), alloc)
+		{}
+
+		bidirectional_paths(const Graph& g, WeightMap map, const Allocator& alloc = Allocator{})
+			: graph(std::addressof(g)), weights(std::move(map)),
+			  offsets(alloc), sources(alloc), lengths(alloc), forward(alloc), backward(alloc)
+		{
+			if constexpr (!symmetric) {
+				reverse();
+			}
+		}
+
+		// true if target is reachable from origin, distance() and path() then
+		// describe a shortest path between them
+		bool run(const vertex_type& origin, const vertex_type& target)
+		{
+			const std::size_t bound = graph->id_bound();
+			forward.prepare(bound);
+			backward.prepare(bound);
+			best = unreached;
+			meet = no_parent;
+			settles = 0;
+
+			const std::size_t from = graph->id_of(origin);
+			const std::size_t to = graph->id_of(target);
+			if (from >= bound || to >= bound) {
+				return false;
+			}
+
+			forward.start(static_cast<id_type>(from), distance_type{});
+			backward.start(static_cast<id_type>(to), distance_type{});
+			if (from == to)
+			{
+				best = distance_type{};
+				meet = static_cast<id_type>(from);
+				return true;
+			}
+
+			const auto out_edges = [this](id_type id, auto&& f) { detail::for_each_weighted<distance_type>(*graph, weights, id, f); };
+			const auto in_edges = [this](id_type id, auto&& f) { for_each_backward(id, f); };
+
+			auto ahead = forward.next();
+			auto behind = backward.next();
+			while (ahead.second != no_parent && behind.second != no_parent)
+			{
+				if (best != unreached && !(ahead.first + behind.first < best)) {
+					break;
+				}
+
+				if (!(behind.first < ahead.first))
+				{
+					settle(forward, backward, ahead.second, ahead.first, out_edges);
+					ahead = forward.next();
+				}
+				else
+				{
+					settle(backward, forward, behind.second, behind.first, in_edges);
+					behind = backward.next();
+				}
+			}
+			return meet != no_parent;
+		}
+
+		// the length of the path the last query found, unreached if none
+		distance_type distance() const noexcept { return best; }
+
+		// ids settled from either end by the last query
+		std::size_t settled() const noexcept { return settles; }
+
+		// writes the vertices on the path the last query found, origin and
+		// target included, or nothing if it found none
+		template<typename OutputIterator>
+		OutputIterator path(OutputIterator out) const
+		{
+			if (meet == no_parent) {
+				return out;
+			}
+
+			list_type<id_type> ids(sources.get_allocator());
+			forward.trace(meet, ids);
+			const auto middle = ids.size();
+			backward.trace(meet, ids);
+
+			for (std::size_t i = 0; i != middle; ++i) {
+				*out++ = graph->key_of(ids[i]);
+			}
+			// the backward half runs from target to meet, meet is already out
+			for (auto i = ids.size() - 1; i > middle; --i) {
+				*out++ = graph->key_of(ids[i - 1]);
+			}
+			return out;
+		}
+	};
+}
+
+#endif
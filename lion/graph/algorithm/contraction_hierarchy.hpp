@@ -0,0 +1,727 @@
+#ifndef LION_GRAPH_CONTRACTION_HIERARCHY_HPP
+#define LION_GRAPH_CONTRACTION_HIERARCHY_HPP
+
+#include "dijkstra.hpp"
+#include "../vertex_interner.hpp"
+#include "../mapped/mapped_format.hpp"
+
+#include <type_traits>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace lion::graph
+{
+	namespace detail
+	{
+		// file layout, all integers in the writer's byte order:
+		//
+		//   hierarchy_header
+		//   keys		  vertex_count keys, id order
+		//   ranks		  vertex_count ids, the position of every id in the contraction order
+		//   up_offsets	  vertex_count + 1 uint64 arc offsets
+		//   up			  up_count arcs
+		//   down_offsets  vertex_count + 1 uint64 arc offsets
+		//   down		  down_count arcs
+		inline constexpr char hierarchy_magic[8] = { 'L', 'I', 'O', 'N', 'C', 'H', 'R', 'C' };
+		inline constexpr std::uint32_t hierarchy_version = 1;
+
+		struct hierarchy_header
+		{
+			char magic[8];
+			std::uint32_t version;
+			std::uint32_t byte_order;
+			std::uint32_t key_size;
+			std::uint32_t arc_size;
+			std::uint32_t id_size;
+			std::uint32_t reserved;
+			std::uint64_t vertex_count;
+			std::uint64_t up_count;
+			std::uint64_t down_count;
+		};
+	}
+
+	// a contraction hierarchy over a weighted graph for repeated point to
+	// point queries on a network that rarely changes. build() contracts the
+	// vertices one by one, least important first, and adds a shortcut u -> w
+	// through v wherever the path u -> v -> w is the only shortest one left
+	// between u and w, which a witness search bounded to witness_limit
+	// settled ids decides. importance is twice the edge difference, shortcuts
+	// added minus edges removed, plus the neighbors already contracted and
+	// the depth of the hierarchy below the vertex, which spreads contraction
+	// evenly over the graph; it is updated lazily as neighbors go.
+	//
+	// every arc, original or shortcut, is kept at its lower ranked end: up(v)
+	// leaves v towards higher ranks, down(v) holds the arcs from higher ranks
+	// into v, both with the contracted vertex a shortcut bypasses so a path
+	// can be unpacked. queries run through hierarchy_paths
+	template<typename Vertex, typename Distance, typename Allocator = std::allocator<Vertex>>
+	class contraction_hierarchy
+	{
+		static_assert(std::is_arithmetic_v<Distance>, "contraction_hierarchy needs arithmetic weights");
+
+	public:
+		using vertex_type	 = Vertex;
+		using distance_type	 = Distance;
+		using id_type		 = vertex_id;
+		using allocator_type = Allocator;
+		using size_type		 = std::size_t;
+
+		static constexpr id_type npos = static_cast<id_type>(-1);
+
+		// middle is the contracted vertex a shortcut bypasses, npos for original edges
+		struct arc
+		{
+			id_type target;
+			id_type middle;
+			distance_type weight;
+		};
+
+	private:
+		template<typename T>
+		using list_type = std::vector<T, typename std::allocator_traits<Allocator>::template rebind_alloc<T>>;
+
+		static constexpr distance_type unreached = std::numeric_limits<distance_type>::max();
+
+		vertex_interner<vertex_type, id_type, allocator_type> vertices;
+		list_type<id_type> ranks;
+		list_type<std::uint64_t> up_offsets;
+		list_type<arc> up_arcs;
+		list_type<std::uint64_t> down_offsets;
+		list_type<arc> down_arcs;
+
+		// the graph while it is being contracted, outs[v] and ins[v] hold the
+		// arcs between v and the vertices not contracted yet
+		struct builder
+		{
+			list_type<list_type<arc>> outs;
+			list_type<list_type<arc>> ins;
+			detail::search_state<id_type, distance_type, binary_heap, Allocator> witness;
+			std::size_t limit;
+
+			// ranking only estimates the shortcuts, a shorter witness search is
+			// enough for that and may only overcount
+			static constexpr std::size_t estimate_limit = 50;
+
+			builder(std::size_t bound, std::size_t witness_limit, const Allocator& alloc)
+				: outs(bound, list_type<arc>(alloc), alloc), ins(bound, list_type<arc>(alloc), alloc), witness(alloc), limit(witness_limit)
+			{
+				witness.prepare(bound);
+			}
+
+			// keeps only the shortest of parallel arcs
+			void link(id_type from, id_type to, distance_type weight, id_type middle)
+			{
+				auto& out = outs[from];
+				const auto find = std::find_if(out.begin(), out.end(), [to](const arc& a) { return a.target == to; });
+				if (find == out.end())
+				{
+					out.push_back({ to, middle, weight });
+					ins[to].push_back({ from, middle, weight });
+				}
+				else if (weight < find->weight)
+				{
+					*find = { to, middle, weight };
+					auto& in = ins[to];
+					*std::find_if(in.begin(), in.end(), [from](const arc& a) { return a.target == from; }) = { from, middle, weight };
+				}
+			}
+
+			// shortest distances from origin avoiding skip, as far as bound and
+			// for at most settles ids
+			void search(id_type origin, id_type skip, distance_type bound, std::size_t settles)
+			{
+				witness.prepare(outs.size());
+				witness.start(origin, distance_type{});
+				for (std::size_t settled = 0; settled < settles; ++settled)
+				{
+					const auto [length, id] = witness.next();
+					if (id == npos || bound < length) {
+						return;
+					}
+					witness.settled[id] = 1;
+
+					for (const auto& a : outs[id])
+					{
+						if (a.target != skip && witness.lower(a.target, id, length + a.weight)) {
+							witness.heap.push(a.target, length + a.weight);
+						}
+					}
+				}
+			}
+
+			// the shortcuts contracting v needs, added to the graph when apply is set
+			std::size_t shortcuts(id_type v, bool apply)
+			{
+				struct shortcut
+				{
+					id_type from;
+					id_type to;
+					distance_type weight;
+				};
+
+				std::size_t count = 0;
+				list_type<shortcut> added(outs.get_allocator());
+				for (const auto& in : ins[v])
+				{
+					bool onward = false;
+					distance_type furthest = 0;
+					for (const auto& out : outs[v])
+					{
+						if (out.target != in.target)
+						{
+							onward = true;
+							furthest = std::max<distance_type>(furthest, in.weight + out.weight);
+						}
+					}
+					if (!onward) {
+						continue;
+					}
+
+					search(in.target, v, furthest, apply ? limit : std::min(limit, estimate_limit));
+					for (const auto& out : outs[v])
+					{
+						const distance_type through = in.weight + out.weight;
+						if (out.target != in.target && through < witness.distances[out.target])
+						{
+							++count;
+							if (apply) {
+								added.push_back({ in.target, out.target, through });
+							}
+						}
+					}
+				}
+				for (const auto& edge : added) {
+					link(edge.from, edge.to, edge.weight, v);
+				}
+				return count;
+			}
+
+			void remove(id_type v)
+			{
+				for (const auto& in : ins[v])
+				{
+					auto& out = outs[in.target];
+					out.erase(std::find_if(out.begin(), out.end(), [v](const arc& a) { return a.target == v; }));
+				}
+				for (const auto& out : outs[v])
+				{
+					auto& in = ins[out.target];
+					in.erase(std::find_if(in.begin(), in.end(), [v](const arc& a) { return a.target == v; }));
+				}
+			}
+		};
+
+		// what load() needs to trust a file: offsets rise from 0 to the arc
+		// count, arcs stay among the vertices and every shortcut bypasses a
+		// vertex ranked below both its ends whose own arcs lead to them, so
+		// unpack() stays in bounds and comes to an end
+		bool consistent() const
+		{
+			const std::size_t n = ranks.size();
+			if (std::any_of(ranks.begin(), ranks.end(), [n](id_type rank) { return rank >= n; })) {
+				return false;
+			}
+
+			const auto bounded = [n](const list_type<std::uint64_t>& offsets, const list_type<arc>& arcs) {
+				if (offsets[0] != 0 || offsets[n] != arcs.size()) {
+					return false;
+				}
+				for (std::size_t id = 0; id < n; ++id)
+				{
+					if (offsets[id + 1] < offsets[id]) {
+						return false;
+					}
+				}
+				return std::all_of(arcs.begin(), arcs.end(), [n](const arc& a) {
+					return a.target < n && (a.middle == npos || a.middle < n);
+				});
+			};
+			if (!bounded(up_offsets, up_arcs) || !bounded(down_offsets, down_arcs)) {
+				return false;
+			}
+
+			const auto reaches = [](range<const arc*> arcs, id_type target) {
+				return std::any_of(arcs.begin(), arcs.end(), [target](const arc& a) { return a.target == target; });
+			};
+			const auto unpacks = [&](id_type from, id_type to, id_type middle) {
+				return middle == npos || (ranks[middle] < ranks[from] && ranks[middle] < ranks[to] &&
+					reaches(down(middle), from) && reaches(up(middle), to));
+			};
+			for (std::size_t id = 0; id < n; ++id)
+			{
+				const auto v = static_cast<id_type>(id);
+				for (const auto& a : up(v))
+				{
+					if (!unpacks(v, a.target, a.middle)) {
+						return false;
+					}
+				}
+				for (const auto& a : down(v))
+				{
+					if (!unpacks(a.target, v, a.middle)) {
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+
+		template<typename List>
+		static void flatten(const List& rows, list_type<std::uint64_t>& offsets, list_type<arc>& arcs)
+		{
+			offsets.assign(rows.size() + 1, 0);
+			for (std::size_t id = 0; id < rows.size(); ++id) {
+				offsets[id + 1] = offsets[id] + rows[id].size();
+			}
+			arcs.clear();
+			arcs.reserve(offsets.back());
+			for (const auto& row : rows) {
+				arcs.insert(arcs.end(), row.begin(), row.end());
+			}
+		}
+
+		template<typename Graph, typename WeightMap>
+		void contract(const Graph& graph, const WeightMap& weights, std::size_t witness_limit)
+		{
+			using graph_id = decltype(graph.id_of(std::declval<const vertex_type&>()));
+
+			clear();
+			list_type<id_type> remap(graph.id_bound(), npos, ranks.get_allocator());
+			for (const auto& vertex : graph.vertices()) {
+				remap[graph.id_of(vertex)] = vertices.insert(vertex).first;
+			}
+
+			const std::size_t bound = vertices.bound();
+			builder work(bound, witness_limit, ranks.get_allocator());
+			for (std::size_t id = 0; id < remap.size(); ++id)
+			{
+				if (remap[id] == npos) {
+					continue;
+				}
+				detail::for_each_weighted<distance_type>(graph, weights, static_cast<graph_id>(id), [&](graph_id target, distance_type weight) {
+					if (static_cast<std::size_t>(target) != id) {
+						work.link(remap[id], remap[target], weight, npos);
+					}
+				});
+			}
+
+			list_type<long long> priorities(bound, 0, ranks.get_allocator());
+			list_type<std::size_t> contracted_neighbors(bound, 0, ranks.get_allocator());
+			list_type<std::size_t> levels(bound, 0, ranks.get_allocator());
+			list_type<char> contracted(bound, 0, ranks.get_allocator());
+			list_type<id_type> stamps(bound, npos, ranks.get_allocator());
+
+			const auto priority = [&](id_type v) {
+				const auto degree = static_cast<long long>(work.ins[v].size() + work.outs[v].size());
+				const auto difference = static_cast<long long>(work.shortcuts(v, false)) - degree;
+				return 2 * difference + static_cast<long long>(contracted_neighbors[v] + levels[v]);
+			};
+
+			binary_heap<id_type, long long, Allocator> order(ranks.get_allocator());
+			for (std::size_t v = 0; v < bound; ++v)
+			{
+				priorities[v] = priority(static_cast<id_type>(v));
+				order.push(static_cast<id_type>(v), priorities[v]);
+			}
+
+			list_type<list_type<arc>> ups(bound, list_type<arc>(ranks.get_allocator()), ranks.get_allocator());
+			list_type<list_type<arc>> downs(bound, list_type<arc>(ranks.get_allocator()), ranks.get_allocator());
+			ranks.assign(bound, npos);
+
+			for (std::size_t rank = 0; !order.empty(); )
+			{
+				const auto [queued, v] = order.pop();
+				if (contracted[v] || queued != priorities[v]) {
+					continue;
+				}
+
+				// lazy update, a vertex that grew more important since it was queued goes back
+				const auto current = priority(v);
+				if (current > queued)
+				{
+					priorities[v] = current;
+					order.push(v, current);
+					continue;
+				}
+
+				work.shortcuts(v, true);
+				work.remove(v);
+				contracted[v] = 1;
+				ranks[v] = static_cast<id_type>(rank++);
+				ups[v].swap(work.outs[v]);
+				downs[v].swap(work.ins[v]);
+
+				for (const auto* row : { &ups[v], &downs[v] })
+				{
+					for (const auto& a : *row)
+					{
+						if (stamps[a.target] == v) {
+							continue;
+						}
+						stamps[a.target] = v;
+						++contracted_neighbors[a.target];
+						levels[a.target] = std::max(levels[a.target], levels[v] + 1);
+						priorities[a.target] = priority(a.target);
+						order.push(a.target, priorities[a.target]);
+					}
+				}
+			}
+
+			flatten(ups, up_offsets, up_arcs);
+			flatten(downs, down_offsets, down_arcs);
+		}
+
+	public:
+		explicit contraction_hierarchy(const allocator_type& alloc = allocator_type{})
+			: vertices(alloc), ranks(alloc), up_offsets(1, 0, alloc), up_arcs(alloc), down_offsets(1, 0, alloc), down_arcs(alloc)
+		{}
+
+		// contracts a weighted graph, reading its own weights
+		template<typename Graph>
+		void build(const Graph& graph, std::size_t witness_limit = 500)
+		{
+			if constexpr (is_weighted_indexed_graph_v<Graph>) {
+				contract(graph, graph_weights<Graph>(graph), witness_limit);
+			}
+			else
+			{
+				// number the vertices once, the contraction then runs on flat ids
+				wdigraph<vertex_type, typename Graph::weight_type, csr, Allocator> frozen;
+				frozen.assign(graph);
+				contract(frozen, graph_weights<decltype(frozen)>(frozen), witness_limit);
+			}
+		}
+
+		// contracts a graph that numbers its edges under a weight map, e.g.
+		// column_weights of travel times
+		template<typename Graph, typename WeightMap>
+		void build(const Graph& graph, const WeightMap& weights, std::size_t witness_limit = 500)
+		{
+			static_assert(is_indexed_graph_v<Graph>, "weight maps need an indexed graph, freeze the graph into a csr first");
+			contract(graph, weights, witness_limit);
+		}
+
+		void clear()
+		{
+			vertices.clear();
+			ranks.clear();
+			up_offsets.assign(1, 0);
+			up_arcs.clear();
+			down_offsets.assign(1, 0);
+			down_arcs.clear();
+		}
+
+		size_type vertex_count() const noexcept { return vertices.size(); }
+		size_type id_bound() const noexcept { return vertices.bound(); }
+		size_type arc_count() const noexcept { return up_arcs.size() + down_arcs.size(); }
+
+		size_type shortcut_count() const noexcept
+		{
+			const auto shortcut = [](const arc& a) { return a.middle != npos; };
+			return static_cast<size_type>(std::count_if(up_arcs.begin(), up_arcs.end(), shortcut) +
+				std::count_if(down_arcs.begin(), down_arcs.end(), shortcut));
+		}
+
+		id_type id_of(const vertex_type& vertex) const { return vertices.id_of(vertex); }
+		const vertex_type& key_of(id_type id) const { return vertices.key_of(id); }
+		bool contains(const vertex_type& vertex) const { return vertices.contains(vertex); }
+
+		// position of id in the contraction order, 0 went first
+		id_type rank(id_type id) const noexcept { return ranks[id]; }
+
+		range<const arc*> up(id_type id) const noexcept {
+			return { up_arcs.data() + up_offsets[id], up_arcs.data() + up_offsets[id + 1] };
+		}
+
+		range<const arc*> down(id_type id) const noexcept {
+			return { down_arcs.data() + down_offsets[id], down_arcs.data() + down_offsets[id + 1] };
+		}
+
+		// appends the original vertices along the arc from -> to that
+		// bypasses middle, to included and from left out
+		template<typename List>
+		void unpack(id_type from, id_type to, id_type middle, List& ids) const
+		{
+			while (middle != npos)
+			{
+				// from -> middle sits in down(middle), middle -> to in up(middle)
+				const auto in = down(middle);
+				unpack(from, middle, std::find_if(in.begin(), in.end(), [from](const arc& a) { return a.target == from; })->middle, ids);
+
+				const auto out = up(middle);
+				from = middle;
+				middle = std::find_if(out.begin(), out.end(), [to](const arc& a) { return a.target == to; })->middle;
+			}
+			ids.push_back(to);
+		}
+
+		// writes the hierarchy to path, false if the file could not be written
+		bool save(const std::string& path) const
+		{
+			static_assert(std::is_trivially_copyable_v<vertex_type>, "saved hierarchies need trivially copyable keys");
+
+			detail::hierarchy_header header{};
+			std::memcpy(header.magic, detail::hierarchy_magic, sizeof(header.magic));
+			header.version = detail::hierarchy_version;
+			header.byte_order = detail::mapped_byte_order;
+			header.key_size = sizeof(vertex_type);
+			header.arc_size = sizeof(arc);
+			header.id_size = sizeof(id_type);
+			header.vertex_count = vertices.bound();
+			header.up_count = up_arcs.size();
+			header.down_count = down_arcs.size();
+
+			std::ofstream out(path, std::ios::binary | std::ios::trunc);
+			const auto write = [&out](const void* data, std::size_t bytes) {
+				out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+			};
+
+			write(&header, sizeof(header));
+			for (std::size_t id = 0; id < vertices.bound(); ++id) {
+				write(std::addressof(vertices.key_of(static_cast<id_type>(id))), sizeof(vertex_type));
+			}
+			write(ranks.data(), ranks.size() * sizeof(id_type));
+			write(up_offsets.data(), up_offsets.size() * sizeof(std::uint64_t));
+			write(up_arcs.data(), up_arcs.size() * sizeof(arc));
+			write(down_offsets.data(), down_offsets.size() * sizeof(std::uint64_t));
+			write(down_arcs.data(), down_arcs.size() * sizeof(arc));
+
+			out.close();
+			return !out.fail();
+		}
+
+		// reads a hierarchy written by save() on a machine with the same key,
+		// weight and id layout. false, leaving the hierarchy empty, otherwise
+		bool load(const std::string& path)
+		{
+			static_assert(std::is_trivially_copyable_v<vertex_type>, "saved hierarchies need trivially copyable keys");
+
+			clear();
+			std::ifstream in(path, std::ios::binary | std::ios::ate);
+			const auto length = static_cast<std::uint64_t>(in ? static_cast<std::streamoff>(in.tellg()) : 0);
+			in.seekg(0);
+			const auto read = [&in](void* data, std::size_t bytes) {
+				in.read(static_cast<char*>(data), static_cast<std::streamsize>(bytes));
+				return static_cast<bool>(in);
+			};
+
+			// every section has to fit in what is left of the file, before
+			// anything is allocated for it
+			std::uint64_t left = length < sizeof(detail::hierarchy_header) ? 0 : length - sizeof(detail::hierarchy_header);
+			const auto take = [&left](std::uint64_t count, std::uint64_t unit) {
+				if (count > left / unit) {
+					return false;
+				}
+				left -= count * unit;
+				return true;
+			};
+
+			detail::hierarchy_header header{};
+			const bool valid = read(&header, sizeof(header)) &&
+				std::memcmp(header.magic, detail::hierarchy_magic, sizeof(header.magic)) == 0 &&
+				header.version == detail::hierarchy_version &&
+				header.byte_order == detail::mapped_byte_order &&
+				header.key_size == sizeof(vertex_type) &&
+				header.arc_size == sizeof(arc) &&
+				header.id_size == sizeof(id_type) &&
+				header.vertex_count < npos &&
+				take(header.vertex_count, sizeof(vertex_type)) &&
+				take(header.vertex_count, sizeof(id_type)) &&
+				take(header.vertex_count + 1, sizeof(std::uint64_t)) &&
+				take(header.up_count, sizeof(arc)) &&
+				take(header.vertex_count + 1, sizeof(std::uint64_t)) &&
+				take(header.down_count, sizeof(arc)) &&
+				left == 0;
+			if (!valid) {
+				return false;
+			}
+
+			const auto n = static_cast<std::size_t>(header.vertex_count);
+			list_type<vertex_type> keys(n, vertex_type{}, ranks.get_allocator());
+			ranks.resize(n);
+			up_offsets.resize(n + 1);
+			up_arcs.resize(static_cast<std::size_t>(header.up_count));
+			down_offsets.resize(n + 1);
+			down_arcs.resize(static_cast<std::size_t>(header.down_count));
+
+			const bool complete =
+				read(keys.data(), n * sizeof(vertex_type)) &&
+				read(ranks.data(), n * sizeof(id_type)) &&
+				read(up_offsets.data(), (n + 1) * sizeof(std::uint64_t)) &&
+				read(up_arcs.data(), up_arcs.size() * sizeof(arc)) &&
+				read(down_offsets.data(), (n + 1) * sizeof(std::uint64_t)) &&
+				read(down_arcs.data(), down_arcs.size() * sizeof(arc)) &&
+				consistent();
+			if (!complete)
+			{
+				clear();
+				return false;
+			}
+
+			for (const auto& key : keys)
+			{
+				if (!vertices.insert(key).second)
+				{
+					clear();
+					return false;
+				}
+			}
+			return true;
+		}
+
+		allocator_type get_allocator() const { return vertices.get_allocator(); }
+	};
+
+	// point to point queries on a contraction_hierarchy: a dijkstra from each
+	// end that only climbs, up() from the origin and down() backwards from the
+	// target, meeting at the highest vertex of the shortest path. a side stops
+	// once its frontier is no nearer than the best meeting, and a vertex is
+	// stalled, its arcs left alone, when an arc from a higher vertex already
+	// shows a shorter way to it. the path is unpacked from the shortcuts on
+	// request. like shortest_paths, a query resets only what the last touched
+	template<typename Hierarchy, template<typename, typename, typename> typename Heap = binary_heap>
+	class hierarchy_paths
+	{
+	public:
+		using hierarchy_type = Hierarchy;
+		using vertex_type	 = typename Hierarchy::vertex_type;
+		using id_type		 = typename Hierarchy::id_type;
+		using distance_type	 = typename Hierarchy::distance_type;
+		using allocator_type = typename Hierarchy::allocator_type;
+
+		static constexpr distance_type unreached = std::numeric_limits<distance_type>::max();
+		static constexpr id_type no_parent = static_cast<id_type>(-1);
+
+	private:
+		using state_type = detail::search_state<id_type, distance_type, Heap, allocator_type>;
+		using arc_range = range<const typename Hierarchy::arc*>;
+
+		const Hierarchy* hierarchy;
+		state_type forward;
+		state_type backward;
+
+		distance_type best = unreached;
+		id_type meet = no_parent;
+		std::size_t settles = 0;
+
+		// settles the next id of one side, false once that side is done
+		bool step(state_type& self, const state_type& other, arc_range (Hierarchy::*climb)(id_type) const,
+			arc_range (Hierarchy::*stall)(id_type) const)
+		{
+			const auto [length, id] = self.next();
+			if (id == no_parent || !(length < best)) {
+				return false;
+			}
+			self.settled[id] = 1;
+			++settles;
+
+			if (other.distances[id] != unreached && length + other.distances[id] < best)
+			{
+				best = length + other.distances[id];
+				meet = id;
+			}
+
+			for (const auto& a : (hierarchy->*stall)(id))
+			{
+				if (self.distances[a.target] != unreached && self.distances[a.target] + a.weight < length) {
+					return true;
+				}
+			}
+			for (const auto& a : (hierarchy->*climb)(id))
+			{
+				if (self.lower(a.target, id, length + a.weight)) {
+					self.heap.push(a.target, length + a.weight);
+				}
+			}
+			return true;
+		}
+
+	public:
+		explicit hierarchy_paths(const Hierarchy& h)
+			: hierarchy(std::addressof(h)), forward(h.get_allocator()), backward(h.get_allocator())
+		{}
+
+		// true if target is reachable from origin, distance() and path() then
+		// describe a shortest path between them
+		bool run(const vertex_type& origin, const vertex_type& target)
+		{
+			const std::size_t bound = hierarchy->id_bound();
+			forward.prepare(bound);
+			backward.prepare(bound);
+			best = unreached;
+			meet = no_parent;
+			settles = 0;
+
+			if (!hierarchy->contains(origin) || !hierarchy->contains(target)) {
+				return false;
+			}
+
+			forward.start(hierarchy->id_of(origin), distance_type{});
+			backward.start(hierarchy->id_of(target), distance_type{});
+
+			bool ahead = true;
+			bool behind = true;
+			while (ahead || behind)
+			{
+				if (ahead) {
+					ahead = step(forward, backward, &Hierarchy::up, &Hierarchy::down);
+				}
+				if (behind) {
+					behind = step(backward, forward, &Hierarchy::down, &Hierarchy::up);
+				}
+			}
+			return meet != no_parent;
+		}
+
+		// the length of the path the last query found, unreached if none
+		distance_type distance() const noexcept { return best; }
+
+		// ids settled from either end by the last query
+		std::size_t settled() const noexcept { return settles; }
+
+		// writes the vertices on the path the last query found, origin and
+		// target included, or nothing if it found none
+		template<typename OutputIterator>
+		OutputIterator path(OutputIterator out) const
+		{
+			if (meet == no_parent) {
+				return out;
+			}
+
+			using id_list = std::vector<id_type, typename std::allocator_traits<allocator_type>::template rebind_alloc<id_type>>;
+			const auto find = [](arc_range arcs, id_type target) {
+				return std::find_if(arcs.begin(), arcs.end(), [target](const auto& a) { return a.target == target; })->middle;
+			};
+
+			// origin up to meet along up() of the lower ends
+			id_list chain(hierarchy->get_allocator());
+			forward.trace(meet, chain);
+			id_list ids(1, chain.front(), hierarchy->get_allocator());
+			for (std::size_t i = 0; i + 1 < chain.size(); ++i) {
+				hierarchy->unpack(chain[i], chain[i + 1], find(hierarchy->up(chain[i]), chain[i + 1]), ids);
+			}
+
+			// meet down to target, the backward tree runs from target to meet
+			chain.clear();
+			backward.trace(meet, chain);
+			for (std::size_t i = chain.size() - 1; i > 0; --i) {
+				hierarchy->unpack(chain[i], chain[i - 1], find(hierarchy->down(chain[i - 1]), chain[i]), ids);
+			}
+
+			for (const auto id : ids) {
+				*out++ = hierarchy->key_of(id);
+			}
+			return out;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,255 @@
+#ifndef LION_GRAPH_DELTA_STEPPING_HPP
+#define LION_GRAPH_DELTA_STEPPING_HPP
+
+#include "../graph_traits.hpp"
+#include "../detail/parallel.hpp"
+#include "../wdigraph.hpp"
+#include "../csr.hpp"
+
+#include <type_traits>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace lion::graph
+{
+	// writes { vertex, distance } for every vertex reachable from origin, in
+	// id order, using Meyer and Sanders' delta stepping on all cores. ids are
+	// kept in buckets of width delta by tentative distance and the lowest
+	// bucket is emptied in rounds: every round relaxes the light edges
+	// (weight <= delta) of the ids in it, which may refill it, and once it
+	// stays empty the heavy edges of everything it held are relaxed once.
+	//
+	// every thread keeps its own buckets and fills them with the ids it
+	// improved; a round pools the threads' lists and hands them out in small
+	// chunks from a shared cursor, so a thread that runs out of work takes
+	// over what the others have not reached. distances are lowered with a
+	// compare and swap. weights must not be negative, delta = 0 picks the
+	// largest weight over the mean out degree and threads = 0 picks by size
+	template<typename Graph, typename OutputIterator, typename Allocator = typename Graph::allocator_type>
+	void delta_stepping(const Graph& graph, const typename Graph::vertex_type& origin, OutputIterator out,
+		typename Graph::weight_type delta = 0, std::size_t threads = 0)
+	{
+		if constexpr (is_weighted_indexed_graph_v<Graph>)
+		{
+			using id_type = decltype(graph.id_of(origin));
+			using weight_type = typename Graph::weight_type;
+			using id_list = std::vector<id_type, typename std::allocator_traits<Allocator>::template rebind_alloc<id_type>>;
+
+			static_assert(std::is_arithmetic_v<weight_type>, "delta_stepping needs arithmetic weights");
+
+			constexpr weight_type unreached = std::numeric_limits<weight_type>::max();
+			constexpr std::size_t none = static_cast<std::size_t>(-1);
+			constexpr std::size_t chunk = 64;
+
+			const std::size_t bound = graph.id_bound();
+			const std::size_t root = graph.id_of(origin);
+			if (root >= bound) {
+				return;
+			}
+
+			const std::size_t scanners = threads ? threads : detail::thread_count(bound, std::size_t(1) << 12);
+			std::vector<std::pair<std::size_t, weight_type>> partial(scanners, { 0, 0 });
+			detail::parallel_for(bound, scanners, [&](std::size_t first, std::size_t last, std::size_t t) {
+				for (auto id = first; id != last; ++id)
+				{
+					for (const weight_type weight : detail::weighted_row(graph, static_cast<id_type>(id)).weights())
+					{
+						partial[t].second = std::max(partial[t].second, weight);
+						++partial[t].first;
+					}
+				}
+			});
+
+			std::size_t edges = 0;
+			weight_type heaviest = 0;
+			for (const auto& [count, weight] : partial)
+			{
+				edges += count;
+				heaviest = std::max(heaviest, weight);
+			}
+
+			if (delta <= 0)
+			{
+				// worked out wide, heaviest * bound overflows integer weights
+				const long double estimate = edges ? static_cast<long double>(heaviest) * bound / edges : 1;
+				const long double largest = static_cast<long double>(std::numeric_limits<weight_type>::max());
+				delta = static_cast<weight_type>(std::min(estimate, largest));
+				if (delta <= 0) {
+					delta = std::is_integral_v<weight_type> ? 1 : heaviest > 0 ? heaviest : 1;
+				}
+			}
+			if (threads == 0) {
+				threads = detail::thread_count(edges);
+			}
+
+			const auto bucket_of = [delta](weight_type distance) {
+				return static_cast<std::size_t>(distance / delta);
+			};
+
+			std::vector<std::atomic<weight_type>, typename std::allocator_traits<Allocator>::template rebind_alloc<std::atomic<weight_type>>> distances(bound);
+			for (auto& distance : distances) {
+				distance.store(unreached, std::memory_order_relaxed);
+			}
+			distances[root].store(0, std::memory_order_relaxed);
+
+			// the bucket an id was last taken out of, so heavy edges are relaxed once per bucket
+			std::vector<std::atomic<std::size_t>, typename std::allocator_traits<Allocator>::template rebind_alloc<std::atomic<std::size_t>>> taken(bound);
+			for (auto& bucket : taken) {
+				bucket.store(none, std::memory_order_relaxed);
+			}
+
+			// only the buckets holding ids are kept, so a small delta on long
+			// distances costs no more than the ids queued
+			using bucket_map = std::map<std::size_t, id_list, std::less<std::size_t>,
+				typename std::allocator_traits<Allocator>::template rebind_alloc<std::pair<const std::size_t, id_list>>>;
+
+			struct local
+			{
+				bucket_map buckets;
+				id_list shared;
+				id_list emptied;
+			};
+			std::vector<local> locals(threads);
+			locals[0].buckets[0].push_back(static_cast<id_type>(root));
+
+			std::vector<std::size_t> sizes(threads, 0);
+			std::vector<std::size_t> lowest(threads, none);
+			std::atomic<std::size_t> cursor(0);
+			detail::barrier sync(threads);
+
+			detail::parallel_for(threads, threads, [&](std::size_t self, std::size_t, std::size_t) {
+				auto& own = locals[self];
+
+				const auto relax = [&](id_type target, weight_type distance) {
+					auto current = distances[target].load(std::memory_order_relaxed);
+					while (distance < current)
+					{
+						if (distances[target].compare_exchange_weak(current, distance, std::memory_order_relaxed))
+						{
+							own.buckets[bucket_of(distance)].push_back(target);
+							return;
+						}
+					}
+				};
+
+				// every thread offers its list, then all of them take chunks of
+				// the pooled lists until none is left. true if anything was pooled
+				const auto share = [&](id_list& offer, auto&& visit) {
+					own.shared.swap(offer);
+					offer.clear();
+					sizes[self] = own.shared.size();
+					sync.wait();
+
+					std::size_t total = 0;
+					for (const auto size : sizes) {
+						total += size;
+					}
+
+					for (std::size_t first; total && (first = cursor.fetch_add(chunk, std::memory_order_relaxed)) < total; )
+					{
+						const std::size_t last = std::min(first + chunk, total);
+						std::size_t from = 0;
+						std::size_t base = 0;
+						while (base + sizes[from] <= first) {
+							base += sizes[from++];
+						}
+						for (auto i = first; i != last; ++i)
+						{
+							while (i - base >= sizes[from]) {
+								base += sizes[from++];
+							}
+							visit(locals[from].shared[i - base]);
+						}
+					}
+					sync.wait();
+
+					if (self == 0) {
+						cursor.store(0, std::memory_order_relaxed);
+					}
+					own.shared.clear();
+					return total != 0;
+				};
+
+				for (std::size_t bucket = 0; bucket != none; )
+				{
+					for (;;)
+					{
+						id_list offer;
+						const auto current = own.buckets.find(bucket);
+						if (current != own.buckets.end())
+						{
+							offer.swap(current->second);
+							own.buckets.erase(current);
+						}
+						const bool more = share(offer, [&](id_type id) {
+							const auto distance = distances[id].load(std::memory_order_relaxed);
+							if (bucket_of(distance) != bucket) {
+								return;
+							}
+							if (taken[id].exchange(bucket, std::memory_order_relaxed) != bucket) {
+								own.emptied.push_back(id);
+							}
+
+							const auto row = detail::weighted_row(graph, id);
+							auto weight = row.weights().begin();
+							for (const id_type target : row.targets())
+							{
+								if (*weight <= delta) {
+									relax(target, distance + *weight);
+								}
+								++weight;
+							}
+						});
+						if (!more) {
+							break;
+						}
+					}
+
+					share(own.emptied, [&](id_type id) {
+						const auto distance = distances[id].load(std::memory_order_relaxed);
+						const auto row = detail::weighted_row(graph, id);
+						auto weight = row.weights().begin();
+						for (const id_type target : row.targets())
+						{
+							if (*weight > delta) {
+								relax(target, distance + *weight);
+							}
+							++weight;
+						}
+					});
+
+					lowest[self] = own.buckets.empty() ? none : own.buckets.begin()->first;
+					sync.wait();
+
+					bucket = *std::min_element(lowest.begin(), lowest.end());
+					sync.wait();
+				}
+			});
+
+			for (std::size_t id = 0; id < bound; ++id)
+			{
+				const auto distance = distances[id].load(std::memory_order_relaxed);
+				if (distance != unreached) {
+					*out++ = std::make_pair(graph.key_of(static_cast<id_type>(id)), distance);
+				}
+			}
+		}
+		else
+		{
+			// number the vertices once, the buckets then hold flat ids
+			wdigraph<typename Graph::vertex_type, typename Graph::weight_type, csr, Allocator> frozen;
+			frozen.assign(graph);
+			delta_stepping<decltype(frozen), OutputIterator, Allocator>(frozen, origin, out, delta, threads);
+		}
+	}
+}
+
+#endif
@@ -1,8 +1,12 @@
 #ifndef LION_GRAPH_DFS_BFS_HPP
-#define LION_GRAPH_DFS_SBFS_HPP
+#define LION_GRAPH_DFS_BFS_HPP
+
+#include "../graph_traits.hpp"
 
 #include <unordered_set>
 #include <functional>
+#include <memory>
+#include <vector>
 #include <stack>
 #include <deque>
 #include <utility>
@@ -13,26 +17,57 @@ namespace lion::graph
 	template<typename Graph, typename OutputIterator, typename Allocator = typename Graph::allocator_type>
 	inline void dfs(const Graph& graph, const typename Graph::vertex_type& origin, OutputIterator out)
 	{
-		using vertex_type = typename Graph::vertex_type;
+		if constexpr (is_indexed_graph_v<Graph>)
+		{
+			using id_type = decltype(graph.id_of(origin));
 
-		std::unordered_set<vertex_type, std::hash<vertex_type>, std::equal_to<vertex_type>, Allocator> discovered;
-		std::stack<vertex_type, std::deque<vertex_type, Allocator>> stack;
+			std::vector<char, typename std::allocator_traits<Allocator>::template rebind_alloc<char>> discovered(graph.id_bound(), 0);
+			std::vector<id_type, typename std::allocator_traits<Allocator>::template rebind_alloc<id_type>> stack;
 
-		stack.push(origin);
+			stack.push_back(graph.id_of(origin));
+
+			while (!stack.empty())
+			{
+				const id_type vertex = stack.back();
+				stack.pop_back();
 
-		while (!stack.empty())
+				if (!discovered[vertex])
+				{
+					*out++ = graph.key_of(vertex);
+					discovered[vertex] = 1;
+
+					for (const id_type edge : graph.targets(vertex))
+					{
+						if (!discovered[edge]) {
+							stack.push_back(edge);
+						}
+					}
+				}
+			}
+		}
+		else
 		{
-			vertex_type vertex = stack.top();
-			stack.pop();
+			using vertex_type = typename Graph::vertex_type;
+
+			std::unordered_set<vertex_type, std::hash<vertex_type>, std::equal_to<vertex_type>, Allocator> discovered;
+			std::stack<vertex_type, std::deque<vertex_type, Allocator>> stack;
+
+			stack.push(origin);
 
-			const auto find = discovered.find(vertex);
-			if (find == discovered.end())
+			while (!stack.empty())
 			{
-				*out++ = vertex;
-				discovered.insert(std::move(vertex));
+				vertex_type vertex = stack.top();
+				stack.pop();
 
-				for (const auto& edge : graph.edges(vertex)) {
-					stack.push(edge);
+				const auto find = discovered.find(vertex);
+				if (find == discovered.end())
+				{
+					*out++ = vertex;
+
+					for (const auto& edge : graph.edges(vertex)) {
+						stack.push(edge);
+					}
+					discovered.insert(std::move(vertex));
 				}
 			}
 		}
@@ -41,27 +76,57 @@ namespace lion::graph
 	template<typename Graph, typename OutputIterator, typename Allocator = typename Graph::allocator_type>
 	inline void bfs(const Graph& graph, const typename Graph::vertex_type& origin, OutputIterator out)
 	{
-		using vertex_type = typename Graph::vertex_type;
+		if constexpr (is_indexed_graph_v<Graph>)
+		{
+			using id_type = decltype(graph.id_of(origin));
 
-		std::unordered_set<vertex_type, std::hash<vertex_type>, std::equal_to<vertex_type>, Allocator> discovered;
-		std::queue<vertex_type, std::deque<vertex_type, Allocator>> queue;
+			std::vector<char, typename std::allocator_traits<Allocator>::template rebind_alloc<char>> discovered(graph.id_bound(), 0);
+			std::vector<id_type, typename std::allocator_traits<Allocator>::template rebind_alloc<id_type>> queue;
 
-		discovered.insert(origin);
-		queue.push(origin);
+			queue.reserve(graph.id_bound());
+			discovered[graph.id_of(origin)] = 1;
+			queue.push_back(graph.id_of(origin));
+
+			// the vector doubles as the queue, head walks over the discovered vertices
+			for (std::size_t head = 0; head != queue.size(); ++head)
+			{
+				const id_type vertex = queue[head];
+				*out++ = graph.key_of(vertex);
 
-		while (!queue.empty())
+				for (const id_type edge : graph.targets(vertex))
+				{
+					if (!discovered[edge])
+					{
+						discovered[edge] = 1;
+						queue.push_back(edge);
+					}
+				}
+			}
+		}
+		else
 		{
-			vertex_type vertex = queue.front();
-			*out++ = vertex;
-			queue.pop();
+			using vertex_type = typename Graph::vertex_type;
+
+			std::unordered_set<vertex_type, std::hash<vertex_type>, std::equal_to<vertex_type>, Allocator> discovered;
+			std::queue<vertex_type, std::deque<vertex_type, Allocator>> queue;
+
+			discovered.insert(origin);
+			queue.push(origin);
 
-			for (auto&& edge : graph.edges(vertex))
+			while (!queue.empty())
 			{
-				const auto find = discovered.find(edge);
-				if (find == discovered.end())
+				vertex_type vertex = queue.front();
+				*out++ = vertex;
+				queue.pop();
+
+				for (auto&& edge : graph.edges(vertex))
 				{
-					discovered.insert(edge);
-					queue.push(std::move(edge));
+					const auto find = discovered.find(edge);
+					if (find == discovered.end())
+					{
+						discovered.insert(edge);
+						queue.push(std::move(edge));
+					}
 				}
 			}
 		}
@@ -0,0 +1,316 @@
+#ifndef LION_GRAPH_DIJKSTRA_HPP
+#define LION_GRAPH_DIJKSTRA_HPP
+
+#include "../graph_traits.hpp"
+#include "../edge_columns.hpp"
+#include "../heap.hpp"
+#include "../wdigraph.hpp"
+#include "../csr.hpp"
+
+#include <type_traits>
+#include <algorithm>
+#include <functional>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace lion::graph
+{
+	namespace detail
+	{
+		// the type a weight map hands out, the graph's own weights unless
+		// the map says otherwise
+		template<typename Graph, typename WeightMap>
+		struct distance_of
+		{
+			using type = std::decay_t<std::invoke_result_t<const WeightMap&, std::size_t>>;
+		};
+
+		template<typename Graph>
+		struct distance_of<Graph, graph_weights<Graph>>
+		{
+			using type = typename Graph::weight_type;
+		};
+
+		// calls f(target, weight) for every edge leaving id. the graph's own
+		// weights are read row by row through weighted_row, any other weight
+		// map by edge id
+		template<typename Distance, typename Graph, typename WeightMap, typename Id, typename Function>
+		void for_each_weighted(const Graph& graph, const WeightMap& weights, Id id, Function&& f)
+		{
+			if constexpr (std::is_same_v<WeightMap, graph_weights<Graph>> && is_weighted_indexed_graph_v<Graph>)
+			{
+				const auto row = weighted_row(graph, id);
+				auto weight = row.weights().begin();
+				for (const Id target : row.targets())
+				{
+					f(target, static_cast<Distance>(*weight));
+					++weight;
+				}
+			}
+			else
+			{
+				static_assert(has_edge_ids_v<Graph>, "a weight map reads edge ids, the graph has to number its edges");
+
+				std::size_t edge = graph.first_edge(id);
+				for (const Id target : graph.targets(id))
+				{
+					f(target, static_cast<Distance>(std::invoke(weights, edge)));
+					++edge;
+				}
+			}
+		}
+
+		// one direction of a search: tentative distances, parents, settled
+		// flags and a heap, plus the ids the last query touched so the next
+		// one resets only those
+		template<typename Id, typename Distance, template<typename, typename, typename> typename Heap, typename Allocator>
+		struct search_state
+		{
+			template<typename T>
+			using list_type = std::vector<T, typename std::allocator_traits<Allocator>::template rebind_alloc<T>>;
+
+			static constexpr Distance unreached = std::numeric_limits<Distance>::max();
+			static constexpr Id no_parent = static_cast<Id>(-1);
+
+			list_type<Distance> distances;
+			list_type<Id> parents;
+			list_type<char> settled;
+			list_type<Id> touched;
+			Heap<Id, Distance, Allocator> heap;
+
+			explicit search_state(const Allocator& alloc)
+				: distances(alloc), parents(alloc), settled(alloc), touched(alloc), heap(alloc)
+			{}
+
+			void prepare(std::size_t bound)
+			{
+				if (distances.size() != bound)
+				{
+					distances.assign(bound, unreached);
+					parents.assign(bound, no_parent);
+					settled.assign(bound, 0);
+					heap.reserve(bound);
+				}
+				else
+				{
+					for (const auto id : touched)
+					{
+						distances[id] = unreached;
+						parents[id] = no_parent;
+						settled[id] = 0;
+					}
+				}
+				touched.clear();
+				heap.clear();
+			}
+
+			// lowers the distance of to, true if it was lowered. the caller
+			// pushes to with whatever key its search orders by
+			bool lower(Id to, Id from, Distance length)
+			{
+				if (!(length < distances[to])) {
+					return false;
+				}
+				if (distances[to] == unreached) {
+					touched.push_back(to);
+				}
+				distances[to] = length;
+				parents[to] = from;
+				return true;
+			}
+
+			void start(Id origin, Distance key)
+			{
+				lower(origin, origin, Distance{});
+				heap.push(origin, key);
+			}
+
+			// the unsettled id with the least key, { key, no_parent } once none is left
+			std::pair<Distance, Id> next()
+			{
+				while (!heap.empty())
+				{
+					const auto entry = heap.pop();
+					if (!settled[entry.second]) {
+						return entry;
+					}
+				}
+				return { unreached, no_parent };
+			}
+
+			// appends the ids from the root of id's tree to id
+			template<typename List>
+			void trace(Id id, List& ids) const
+			{
+				const auto first = ids.size();
+				for (;; id = parents[id])
+				{
+					ids.push_back(id);
+					if (parents[id] == id) {
+						break;
+					}
+				}
+				std::reverse(ids.begin() + first, ids.end());
+			}
+		};
+	}
+
+	// single source shortest paths over non-negative weights, kept as a
+	// workspace so a stream of queries reuses its arrays: a query resets only
+	// the ids the previous one touched, so a short point to point query costs
+	// what it explores and not what the graph holds.
+	//
+	// Heap is binary_heap, quaternary_heap or radix_heap (unsigned integer
+	// weights only). WeightMap reads the weight of an edge id, the default
+	// reads the graph's weights row by row through weights(id) or row(id) and
+	// needs no edge ids; column_weights or a projecting graph_weights need them
+	template<
+		typename Graph,
+		template<typename, typename, typename> typename Heap = binary_heap,
+		typename WeightMap = graph_weights<Graph>,
+		typename Allocator = typename Graph::allocator_type
+	>
+	class shortest_paths
+	{
+		static_assert(is_indexed_graph_v<Graph>, "shortest_paths needs an indexed graph, freeze the graph into a csr first");
+
+	public:
+		using graph_type	= Graph;
+		using vertex_type	= typename Graph::vertex_type;
+		using id_type		= decltype(std::declval<const Graph&>().id_of(std::declval<const vertex_type&>()));
+		using distance_type = typename detail::distance_of<Graph, WeightMap>::type;
+
+		static constexpr distance_type unreached = std::numeric_limits<distance_type>::max();
+		static constexpr id_type no_parent = static_cast<id_type>(-1);
+
+	private:
+		template<typename T>
+		using list_type = std::vector<T, typename std::allocator_traits<Allocator>::template rebind_alloc<T>>;
+
+		const Graph* graph;
+		WeightMap weights;
+		detail::search_state<id_type, distance_type, Heap, Allocator> state;
+		list_type<id_type> order;
+
+		// settles ids in order of distance until the heap runs dry or stop
+		// is settled
+		void search(id_type origin, id_type stop)
+		{
+			state.start(origin, distance_type{});
+			for (;;)
+			{
+				const auto [length, id] = state.next();
+				if (id == no_parent) {
+					return;
+				}
+				state.settled[id] = 1;
+				order.push_back(id);
+
+				if (id == stop) {
+					return;
+				}
+
+				detail::for_each_weighted<distance_type>(*graph, weights, id, [&, length = length, id = id](id_type target, distance_type weight) {
+					if (!state.settled[target] && state.lower(target, id, length + weight)) {
+						state.heap.push(target, length + weight);
+					}
+				});
+			}
+		}
+
+		bool prepare(std::size_t from, std::size_t to)
+		{
+			const std::size_t bound = graph->id_bound();
+			state.prepare(bound);
+			order.clear();
+			return from < bound && to < bound;
+		}
+
+	public:
+		explicit shortest_paths(const Graph& g, const Allocator& alloc = Allocator{})
+			: shortest_paths(g, WeightMap(g), alloc)
+		{}
+
+		shortest_paths(const Graph& g, WeightMap map, const Allocator& alloc = Allocator{})
+			: graph(std::addressof(g)), weights(std::move(map)), state(alloc), order(alloc)
+		{}
+
+		// settles every id origin reaches, false if the graph does not hold origin
+		bool run(const vertex_type& origin)
+		{
+			const std::size_t id = graph->id_of(origin);
+			if (!prepare(id, id)) {
+				return false;
+			}
+			search(static_cast<id_type>(id), no_parent);
+			return true;
+		}
+
+		// stops as soon as target is settled, true if target was reached. ids
+		// farther than target are left unsettled and read as unreached
+		bool run(const vertex_type& origin, const vertex_type& target)
+		{
+			const std::size_t from = graph->id_of(origin);
+			const std::size_t to = graph->id_of(target);
+			if (!prepare(from, to)) {
+				return false;
+			}
+			search(static_cast<id_type>(from), static_cast<id_type>(to));
+			return state.settled[to] != 0;
+		}
+
+		bool reached(id_type id) const noexcept { return state.settled[id] != 0; }
+
+		distance_type distance(id_type id) const noexcept { return state.settled[id] ? state.distances[id] : unreached; }
+
+		// the origin is its own parent
+		id_type parent(id_type id) const noexcept { return state.settled[id] ? state.parents[id] : no_parent; }
+
+		// the settled ids in order of distance, the origin first
+		range<const id_type*> settled_ids() const noexcept { return { order.data(), order.data() + order.size() }; }
+
+		// writes the vertices on the shortest path from the origin to target,
+		// both included, or nothing if target was not reached
+		template<typename OutputIterator>
+		OutputIterator path(id_type target, OutputIterator out) const
+		{
+			if (!state.settled[target]) {
+				return out;
+			}
+
+			list_type<id_type> ids(order.get_allocator());
+			state.trace(target, ids);
+			for (const auto id : ids) {
+				*out++ = graph->key_of(id);
+			}
+			return out;
+		}
+	};
+
+	// writes { vertex, distance } for every vertex reachable from origin in
+	// order of distance, weights must not be negative
+	template<typename Graph, typename OutputIterator, typename Allocator = typename Graph::allocator_type>
+	inline void dijkstra(const Graph& graph, const typename Graph::vertex_type& origin, OutputIterator out)
+	{
+		if constexpr (is_indexed_graph_v<Graph>)
+		{
+			shortest_paths<Graph, binary_heap, graph_weights<Graph>, Allocator> paths(graph);
+			paths.run(origin);
+			for (const auto id : paths.settled_ids()) {
+				*out++ = std::make_pair(graph.key_of(id), paths.distance(id));
+			}
+		}
+		else
+		{
+			// number the vertices once, the search then runs on flat arrays
+			wdigraph<typename Graph::vertex_type, typename Graph::weight_type, csr, Allocator> frozen;
+			frozen.assign(graph);
+			dijkstra<decltype(frozen), OutputIterator, Allocator>(frozen, origin, out);
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,147 @@
+#ifndef LION_GRAPH_MULTI_SOURCE_BFS_HPP
+#define LION_GRAPH_MULTI_SOURCE_BFS_HPP
+
+#include "../graph_traits.hpp"
+#include "../detail/bitops.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace lion::graph
+{
+	// breadth first search from up to Sources origins at once, after Then et
+	// al.'s ms-bfs. every id carries one bit per origin in seen, visit and next,
+	// so a row is scanned once per level for all the origins whose frontier
+	// holds it, and the word loops are left for the compiler to vectorize.
+	// the buffers live as long as the object, call it again for every batch
+	template<typename Graph, std::size_t Sources = 64, typename Allocator = typename Graph::allocator_type>
+	class multi_source_bfs
+	{
+		static_assert(is_indexed_graph_v<Graph>, "multi_source_bfs needs an indexed graph, freeze the graph into a csr first");
+		static_assert(Sources != 0 && Sources % detail::word_bits == 0, "multi_source_bfs runs a whole number of 64 bit words of sources");
+
+	public:
+		using graph_type = Graph;
+		using vertex_type = typename Graph::vertex_type;
+		using id_type = decltype(std::declval<const Graph&>().id_of(std::declval<const vertex_type&>()));
+
+		static constexpr std::size_t batch = Sources;
+
+	private:
+		static constexpr std::size_t words = Sources / detail::word_bits;
+
+		using word_list = std::vector<std::uint64_t, typename std::allocator_traits<Allocator>::template rebind_alloc<std::uint64_t>>;
+
+		const Graph* graph;
+		word_list seen;
+		word_list visit;
+		word_list next;
+
+	public:
+		explicit multi_source_bfs(const Graph& graph)
+			: graph(&graph)
+		{}
+
+		// calls f(source, id, hops) once for every id reached from every origin
+		// in [first, last), source being the origin's position in the range.
+		// origins the graph does not hold reach nothing
+		template<typename Iterator, typename Function>
+		void operator()(Iterator first, Iterator last, Function&& f)
+		{
+			for (std::size_t base = 0; first != last; base += Sources)
+			{
+				std::size_t count = 0;
+				const std::size_t bound = graph->id_bound();
+				reset(bound);
+
+				for (; first != last && count != Sources; ++first, ++count)
+				{
+					const std::size_t id = graph->id_of(*first);
+					if (id >= bound) {
+						continue;
+					}
+					const auto bit = std::uint64_t(1) << (count % detail::word_bits);
+					seen[id * words + count / detail::word_bits] |= bit;
+					visit[id * words + count / detail::word_bits] |= bit;
+					f(base + count, static_cast<id_type>(id), std::size_t(0));
+				}
+				run(bound, base, f);
+			}
+		}
+
+	private:
+		void reset(std::size_t bound)
+		{
+			seen.assign(bound * words, 0);
+			visit.assign(bound * words, 0);
+			next.assign(bound * words, 0);
+		}
+
+		template<typename Function>
+		void run(std::size_t bound, std::size_t base, Function& f)
+		{
+			for (std::size_t hops = 1; ; ++hops)
+			{
+				// push every frontier row's origins to its targets
+				for (std::size_t id = 0; id < bound; ++id)
+				{
+					const std::uint64_t* from = visit.data() + id * words;
+					std::uint64_t any = 0;
+					for (std::size_t w = 0; w < words; ++w) {
+						any |= from[w];
+					}
+					if (!any) {
+						continue;
+					}
+
+					for (const id_type target : graph->targets(static_cast<id_type>(id)))
+					{
+						std::uint64_t* to = next.data() + static_cast<std::size_t>(target) * words;
+						for (std::size_t w = 0; w < words; ++w) {
+							to[w] |= from[w];
+						}
+					}
+				}
+
+				// keep the bits not seen before as the next frontier
+				bool active = false;
+				for (std::size_t id = 0; id < bound; ++id)
+				{
+					std::uint64_t* own = seen.data() + id * words;
+					std::uint64_t* frontier = visit.data() + id * words;
+					std::uint64_t* reached = next.data() + id * words;
+
+					std::uint64_t any = 0;
+					for (std::size_t w = 0; w < words; ++w)
+					{
+						const auto fresh = reached[w] & ~own[w];
+						own[w] |= fresh;
+						frontier[w] = fresh;
+						reached[w] = 0;
+						any |= fresh;
+					}
+					if (!any) {
+						continue;
+					}
+
+					active = true;
+					for (std::size_t w = 0; w < words; ++w)
+					{
+						for (auto word = frontier[w]; word; word &= word - 1) {
+							f(base + w * detail::word_bits + detail::countr_zero(word), static_cast<id_type>(id), hops);
+						}
+					}
+				}
+
+				if (!active) {
+					return;
+				}
+			}
+		}
+	};
+}
+
+#endif
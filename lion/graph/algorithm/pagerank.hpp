@@ -0,0 +1,117 @@
+#ifndef LION_GRAPH_PAGERANK_HPP
+#define LION_GRAPH_PAGERANK_HPP
+
+#include "../graph_traits.hpp"
+#include "../digraph.hpp"
+#include "../csr.hpp"
+
+#include <vector>
+#include <cstddef>
+#include <cmath>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace lion::graph
+{
+	// writes { vertex, rank } for every vertex, the ranks sum to 1 and the
+	// rank of vertices without edges is spread evenly. graphs that list their
+	// predecessors are iterated pull style, every vertex sums the shares of its
+	// in-neighbors and each rank is written exactly once per round
+	template<typename Graph, typename OutputIterator, typename Allocator = typename Graph::allocator_type>
+	inline void pagerank(const Graph& graph, OutputIterator out,
+		double damping = 0.85, std::size_t iterations = 100, double tolerance = 1e-9)
+	{
+		if constexpr (is_indexed_graph_v<Graph>)
+		{
+			using id_type = decltype(graph.id_of(std::declval<const typename Graph::vertex_type&>()));
+			using real_list = std::vector<double, typename std::allocator_traits<Allocator>::template rebind_alloc<double>>;
+
+			std::vector<id_type, typename std::allocator_traits<Allocator>::template rebind_alloc<id_type>> live;
+			live.reserve(graph.vertex_count());
+			for (const auto& vertex : graph.vertices()) {
+				live.push_back(graph.id_of(vertex));
+			}
+			if (live.empty()) {
+				return;
+			}
+
+			const std::size_t bound = graph.id_bound();
+			const double count = static_cast<double>(live.size());
+
+			std::vector<std::size_t, typename std::allocator_traits<Allocator>::template rebind_alloc<std::size_t>> degrees(bound, 0);
+			for (const auto id : live)
+			{
+				const auto targets = graph.targets(id);
+				degrees[id] = static_cast<std::size_t>(std::distance(targets.begin(), targets.end()));
+			}
+
+			real_list rank(bound, 0.0);
+			real_list next(bound, 0.0);
+			real_list share(bound, 0.0);
+			for (const auto id : live) {
+				rank[id] = 1.0 / count;
+			}
+
+			for (std::size_t round = 0; round < iterations; ++round)
+			{
+				double dangling = 0;
+				for (const auto id : live)
+				{
+					if (degrees[id] == 0) {
+						dangling += rank[id];
+					}
+					share[id] = degrees[id] ? damping * rank[id] / degrees[id] : 0.0;
+				}
+				const double base = (1 - damping) / count + damping * dangling / count;
+
+				if constexpr (is_bidirectional_graph_v<Graph>)
+				{
+					for (const auto id : live)
+					{
+						double sum = base;
+						for (const id_type source : graph.sources(id)) {
+							sum += share[source];
+						}
+						next[id] = sum;
+					}
+				}
+				else
+				{
+					for (const auto id : live) {
+						next[id] = base;
+					}
+					for (const auto id : live)
+					{
+						for (const id_type target : graph.targets(id)) {
+							next[target] += share[id];
+						}
+					}
+				}
+
+				double delta = 0;
+				for (const auto id : live) {
+					delta += std::abs(next[id] - rank[id]);
+				}
+				rank.swap(next);
+
+				if (delta < tolerance) {
+					break;
+				}
+			}
+
+			for (const auto id : live) {
+				*out++ = std::make_pair(graph.key_of(id), rank[id]);
+			}
+		}
+		else
+		{
+			// number the vertices once, the rounds then run on flat arrays
+			digraph<typename Graph::vertex_type, csr, Allocator> frozen;
+			frozen.assign(graph);
+			pagerank<decltype(frozen), OutputIterator, Allocator>(frozen, out, damping, iterations, tolerance);
+		}
+	}
+}
+
+#endif
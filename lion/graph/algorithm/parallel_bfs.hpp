@@ -0,0 +1,289 @@
+#ifndef LION_GRAPH_PARALLEL_BFS_HPP
+#define LION_GRAPH_PARALLEL_BFS_HPP
+
+#include "../graph_traits.hpp"
+#include "../detail/bitops.hpp"
+#include "../detail/parallel.hpp"
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <algorithm>
+
+namespace lion::graph
+{
+	// hop distance and bfs tree parent of every id, the origin is its own
+	// parent and ids origin does not reach keep unreached and no_parent
+	template<typename Id, typename Allocator>
+	struct bfs_tree
+	{
+		static constexpr std::size_t unreached = static_cast<std::size_t>(-1);
+		static constexpr Id no_parent = static_cast<Id>(-1);
+
+		std::vector<std::size_t, typename std::allocator_traits<Allocator>::template rebind_alloc<std::size_t>> distance;
+		std::vector<Id, typename std::allocator_traits<Allocator>::template rebind_alloc<Id>> parent;
+	};
+
+	namespace detail
+	{
+		// the predecessors of every id of a graph that does not list them. each
+		// thread owns a slice of the targets and scans every row, so counts and
+		// cursors need no atomics and every row lists its sources in id order
+		template<typename Id, typename Allocator>
+		struct transposed_rows
+		{
+			std::vector<std::size_t, typename std::allocator_traits<Allocator>::template rebind_alloc<std::size_t>> offsets;
+			std::vector<Id, typename std::allocator_traits<Allocator>::template rebind_alloc<Id>> sources;
+
+			template<typename Graph>
+			void build(const Graph& graph, std::size_t threads)
+			{
+				const std::size_t bound = graph.id_bound();
+
+				const auto scan = [&graph, bound](std::size_t first, std::size_t last, auto&& f) {
+					for (std::size_t id = 0; id < bound; ++id)
+					{
+						for (const Id target : graph.targets(static_cast<Id>(id)))
+						{
+							if (target >= first && target < last) {
+								f(static_cast<Id>(id), target);
+							}
+						}
+					}
+				};
+
+				offsets.assign(bound + 1, 0);
+				parallel_for(bound, threads, [&](std::size_t first, std::size_t last, std::size_t) {
+					scan(first, last, [this](Id, Id target) { ++offsets[target + 1]; });
+				});
+				for (std::size_t id = 0; id < bound; ++id) {
+					offsets[id + 1] += offsets[id];
+				}
+
+				sources.resize(offsets[bound]);
+				std::vector<std::size_t, typename std::allocator_traits<Allocator>::template rebind_alloc<std::size_t>> cursors(offsets.begin(), offsets.end() - 1);
+				parallel_for(bound, threads, [&](std::size_t first, std::size_t last, std::size_t) {
+					scan(first, last, [&](Id source, Id target) { sources[cursors[target]++] = source; });
+				});
+			}
+		};
+	}
+
+	// breadth first search from origin on all cores, direction optimizing as
+	// in Beamer et al. levels are expanded top down from a queue while the
+	// frontier is small; once its edges outnumber a fifteenth of the edges
+	// still unexplored, every unvisited id instead pulls from its predecessors
+	// and stops at the first one on the frontier, until the frontier shrinks
+	// below an eighteenth of the ids. the visited set is an atomic bitmap and
+	// every thread grows its own part of the next frontier. predecessors come
+	// from sources(id) when the graph has them, otherwise they are built in
+	// parallel at the first bottom up level. threads = 0 picks by graph size
+	template<typename Graph, typename Allocator = typename Graph::allocator_type>
+	auto parallel_bfs(const Graph& graph, const typename Graph::vertex_type& origin, std::size_t threads = 0)
+	{
+		static_assert(is_indexed_graph_v<Graph>, "parallel_bfs needs an indexed graph, freeze the graph into a csr first");
+
+		using id_type = decltype(graph.id_of(origin));
+		using word_type = std::uint64_t;
+		using result_type = bfs_tree<id_type, Allocator>;
+		using id_list = std::vector<id_type, typename std::allocator_traits<Allocator>::template rebind_alloc<id_type>>;
+		using bit_list = std::vector<std::atomic<word_type>, typename std::allocator_traits<Allocator>::template rebind_alloc<std::atomic<word_type>>>;
+
+		constexpr std::size_t alpha = 15;
+		constexpr std::size_t beta = 18;
+		constexpr std::size_t grain = std::size_t(1) << 12;
+
+		const std::size_t bound = graph.id_bound();
+		const std::size_t words = detail::words_for(bound);
+
+		result_type result;
+		result.distance.assign(bound, result_type::unreached);
+		result.parent.assign(bound, result_type::no_parent);
+
+		const auto root = graph.id_of(origin);
+		if (root >= bound) {
+			return result;
+		}
+
+		const auto degree = [&graph](id_type id) {
+			const auto row = graph.targets(id);
+			return static_cast<std::size_t>(std::distance(row.begin(), row.end()));
+		};
+
+		// a level gets threads by its work, capped by the caller's choice
+		const std::size_t hardware = threads ? threads : detail::thread_count(bound, 1);
+		const auto threads_for = [&](std::size_t work) {
+			return std::min(hardware, detail::thread_count(work, grain));
+		};
+
+		std::vector<std::size_t> partial(hardware, 0);
+		detail::parallel_for(bound, threads_for(bound), [&](std::size_t first, std::size_t last, std::size_t t) {
+			std::size_t sum = 0;
+			for (auto id = first; id != last; ++id) {
+				sum += degree(static_cast<id_type>(id));
+			}
+			partial[t] = sum;
+		});
+		std::size_t unexplored = 0;
+		for (const auto sum : partial) {
+			unexplored += sum;
+		}
+
+		bit_list visited(words);
+		bit_list current(words);
+		bit_list next(words);
+
+		const auto test = [](const bit_list& bits, std::size_t id) {
+			return (bits[id / detail::word_bits].load(std::memory_order_relaxed) >> (id % detail::word_bits)) & 1;
+		};
+		// true for the one caller that sets the bit
+		const auto claim = [](bit_list& bits, std::size_t id) {
+			const auto bit = word_type(1) << (id % detail::word_bits);
+			auto& word = bits[id / detail::word_bits];
+			return !(word.load(std::memory_order_relaxed) & bit) && !(word.fetch_or(bit, std::memory_order_relaxed) & bit);
+		};
+
+		detail::transposed_rows<id_type, Allocator> transposed;
+		bool have_sources = is_bidirectional_graph_v<Graph>;
+
+		id_list queue;
+		std::vector<id_list> locals(hardware);
+		std::vector<std::size_t> scouts(hardware, 0);
+
+		result.distance[root] = 0;
+		result.parent[root] = root;
+		claim(visited, root);
+		queue.push_back(root);
+
+		std::size_t frontier = 1;
+		std::size_t scout = degree(root);
+		bool bottom_up = false;
+
+		for (std::size_t level = 0; frontier != 0; ++level)
+		{
+			unexplored -= std::min(unexplored, scout);
+
+			if (!bottom_up && scout > unexplored / alpha)
+			{
+				bottom_up = true;
+				for (auto& word : current) {
+					word.store(0, std::memory_order_relaxed);
+				}
+				for (const auto id : queue) {
+					claim(current, id);
+				}
+				if (!have_sources)
+				{
+					transposed.build(graph, threads_for(bound + unexplored));
+					have_sources = true;
+				}
+			}
+			else if (bottom_up && frontier < bound / beta)
+			{
+				bottom_up = false;
+				queue.clear();
+				for (std::size_t w = 0; w < words; ++w)
+				{
+					for (auto word = current[w].load(std::memory_order_relaxed); word; word &= word - 1) {
+						queue.push_back(static_cast<id_type>(w * detail::word_bits + detail::countr_zero(word)));
+					}
+				}
+			}
+
+			const auto depth = level + 1;
+			std::fill(scouts.begin(), scouts.end(), 0);
+
+			if (bottom_up)
+			{
+				for (auto& word : next) {
+					word.store(0, std::memory_order_relaxed);
+				}
+
+				// whole words per thread, so no two threads share a word of visited or next
+				std::vector<std::size_t> found(hardware, 0);
+				detail::parallel_for(words, threads_for(bound), [&](std::size_t first, std::size_t last, std::size_t t) {
+					const auto pull = [&](id_type id, const auto& sources) {
+						for (const id_type source : sources)
+						{
+							if (test(current, source))
+							{
+								result.parent[id] = source;
+								result.distance[id] = depth;
+								claim(visited, id);
+								claim(next, id);
+								++found[t];
+								scouts[t] += degree(id);
+								return;
+							}
+						}
+					};
+
+					const auto end = std::min(last * detail::word_bits, bound);
+					for (auto id = first * detail::word_bits; id < end; ++id)
+					{
+						if (test(visited, id)) {
+							continue;
+						}
+						if constexpr (is_bidirectional_graph_v<Graph>) {
+							pull(static_cast<id_type>(id), graph.sources(static_cast<id_type>(id)));
+						}
+						else
+						{
+							pull(static_cast<id_type>(id), range<const id_type*>{
+								transposed.sources.data() + transposed.offsets[id],
+								transposed.sources.data() + transposed.offsets[id + 1]
+							});
+						}
+					}
+				});
+
+				current.swap(next);
+				frontier = 0;
+				for (const auto count : found) {
+					frontier += count;
+				}
+			}
+			else
+			{
+				detail::parallel_for(queue.size(), threads_for(scout), [&](std::size_t first, std::size_t last, std::size_t t) {
+					auto& mine = locals[t];
+					mine.clear();
+					for (auto i = first; i != last; ++i)
+					{
+						const id_type vertex = queue[i];
+						for (const id_type target : graph.targets(vertex))
+						{
+							if (claim(visited, target))
+							{
+								result.parent[target] = vertex;
+								result.distance[target] = depth;
+								mine.push_back(target);
+								scouts[t] += degree(target);
+							}
+						}
+					}
+				});
+
+				queue.clear();
+				for (auto& mine : locals)
+				{
+					queue.insert(queue.end(), mine.begin(), mine.end());
+					mine.clear();
+				}
+				frontier = queue.size();
+			}
+
+			scout = 0;
+			for (const auto count : scouts) {
+				scout += count;
+			}
+		}
+		return result;
+	}
+}
+
+#endif
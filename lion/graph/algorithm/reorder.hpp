@@ -0,0 +1,191 @@
+#ifndef LION_GRAPH_REORDER_HPP
+#define LION_GRAPH_REORDER_HPP
+
+#include "../graph_traits.hpp"
+
+#include <vector>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <numeric>
+#include <algorithm>
+
+// vertex orders for relabeling an indexed graph, order[i] is the id that
+// should become id i. pass one to permute() of a csr or compressed_csr to
+// rebuild the rows in that order:
+//
+//   const auto remap = graph.permute(lion::graph::rcm_order(graph));
+//
+// remap[old id] is the new id of every vertex
+namespace lion::graph
+{
+	namespace detail
+	{
+		// targets and sources of every live id merged into one symmetric row
+		// set, directions are irrelevant to how close two ids should be placed
+		template<typename Graph, typename Allocator>
+		struct symmetric_rows
+		{
+			using id_type = decltype(std::declval<const Graph&>().id_of(std::declval<const typename Graph::vertex_type&>()));
+			using id_list = std::vector<id_type, typename std::allocator_traits<Allocator>::template rebind_alloc<id_type>>;
+			using size_list = std::vector<std::size_t, typename std::allocator_traits<Allocator>::template rebind_alloc<std::size_t>>;
+
+			id_list live;
+			size_list offsets;
+			id_list targets;
+
+			explicit symmetric_rows(const Graph& graph)
+			{
+				const std::size_t bound = graph.id_bound();
+
+				live.reserve(bound);
+				for (const auto& vertex : graph.vertices()) {
+					live.push_back(graph.id_of(vertex));
+				}
+
+				offsets.assign(bound + 1, 0);
+				for (const id_type id : live)
+				{
+					for (const id_type target : graph.targets(id))
+					{
+						if (target != id)
+						{
+							++offsets[id + 1];
+							++offsets[target + 1];
+						}
+					}
+				}
+				std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+				size_list next(offsets.begin(), offsets.end() - 1);
+				targets.resize(offsets.back());
+				for (const id_type id : live)
+				{
+					for (const id_type target : graph.targets(id))
+					{
+						if (target != id)
+						{
+							targets[next[id]++] = target;
+							targets[next[target]++] = id;
+						}
+					}
+				}
+			}
+
+			std::size_t degree(id_type id) const noexcept {
+				return offsets[id + 1] - offsets[id];
+			}
+		};
+
+		// breadth first from start over the symmetric rows, appending every id
+		// the first time it is reached. neighbours are queued by ascending degree
+		// when by_degree is set, which is what cuthill-mckee asks for
+		template<typename Rows, typename IdList, typename Marks>
+		inline void symmetric_bfs(const Rows& rows, typename Rows::id_type start, bool by_degree, IdList& order, Marks& seen)
+		{
+			seen[start] = 1;
+			order.push_back(start);
+			for (std::size_t head = order.size() - 1; head < order.size(); ++head)
+			{
+				const auto id = order[head];
+				const auto first = order.size();
+				for (auto i = rows.offsets[id]; i != rows.offsets[id + 1]; ++i)
+				{
+					const auto target = rows.targets[i];
+					if (!seen[target])
+					{
+						seen[target] = 1;
+						order.push_back(target);
+					}
+				}
+				if (by_degree)
+				{
+					std::stable_sort(order.begin() + first, order.end(), [&rows](auto lhs, auto rhs) {
+						return rows.degree(lhs) < rows.degree(rhs);
+					});
+				}
+			}
+		}
+	}
+
+	// reverse cuthill-mckee, every component is laid out breadth first from a
+	// vertex of least degree and the whole order is then reversed. keeps the
+	// ids of adjacent vertices close together, which narrows the band of the
+	// adjacency matrix and the gaps a compressed_csr has to encode
+	template<typename Graph, typename Allocator = typename Graph::allocator_type>
+	inline auto rcm_order(const Graph& graph)
+	{
+		static_assert(is_indexed_graph_v<Graph>, "vertex orders need an indexed graph, freeze the graph into a csr first");
+
+		using rows_type = detail::symmetric_rows<Graph, Allocator>;
+		const rows_type rows(graph);
+
+		auto starts = rows.live;
+		std::stable_sort(starts.begin(), starts.end(), [&rows](auto lhs, auto rhs) {
+			return rows.degree(lhs) < rows.degree(rhs);
+		});
+
+		typename rows_type::id_list order;
+		order.reserve(rows.live.size());
+		std::vector<char, typename std::allocator_traits<Allocator>::template rebind_alloc<char>> seen(graph.id_bound(), 0);
+		for (const auto start : starts)
+		{
+			if (!seen[start]) {
+				detail::symmetric_bfs(rows, start, true, order, seen);
+			}
+		}
+		std::reverse(order.begin(), order.end());
+
+		return order;
+	}
+
+	// vertices by descending total degree, ties kept in id order. packs the
+	// hubs that most traversals touch into the first cache lines of every
+	// per-vertex array
+	template<typename Graph, typename Allocator = typename Graph::allocator_type>
+	inline auto degree_order(const Graph& graph)
+	{
+		static_assert(is_indexed_graph_v<Graph>, "vertex orders need an indexed graph, freeze the graph into a csr first");
+
+		using rows_type = detail::symmetric_rows<Graph, Allocator>;
+		const rows_type rows(graph);
+
+		auto order = rows.live;
+		std::stable_sort(order.begin(), order.end(), [&rows](auto lhs, auto rhs) {
+			return rows.degree(lhs) > rows.degree(rhs);
+		});
+
+		return order;
+	}
+
+	// breadth first discovery order, every component starting from its vertex
+	// of highest degree. vertices expanded together get neighbouring ids, a
+	// cheap stand-in for gorder's windowed greedy placement
+	template<typename Graph, typename Allocator = typename Graph::allocator_type>
+	inline auto bfs_order(const Graph& graph)
+	{
+		static_assert(is_indexed_graph_v<Graph>, "vertex orders need an indexed graph, freeze the graph into a csr first");
+
+		using rows_type = detail::symmetric_rows<Graph, Allocator>;
+		const rows_type rows(graph);
+
+		auto starts = rows.live;
+		std::stable_sort(starts.begin(), starts.end(), [&rows](auto lhs, auto rhs) {
+			return rows.degree(lhs) > rows.degree(rhs);
+		});
+
+		typename rows_type::id_list order;
+		order.reserve(rows.live.size());
+		std::vector<char, typename std::allocator_traits<Allocator>::template rebind_alloc<char>> seen(graph.id_bound(), 0);
+		for (const auto start : starts)
+		{
+			if (!seen[start]) {
+				detail::symmetric_bfs(rows, start, false, order, seen);
+			}
+		}
+
+		return order;
+	}
+}
+
+#endif
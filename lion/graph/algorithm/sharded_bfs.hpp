@@ -0,0 +1,103 @@
+#ifndef LION_GRAPH_SHARDED_BFS_HPP
+#define LION_GRAPH_SHARDED_BFS_HPP
+
+#include "../sharded_digraph.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace lion::graph
+{
+	// writes { vertex, hops } for every vertex reachable from origin, shard by
+	// shard. one superstep per level: a shard expands its frontier, keeps the
+	// vertices it owns for the next level and mails every ghost it reaches to
+	// the owner, at most once per ghost. the per-shard state is allocated by
+	// the shard's own thread
+	template<typename Vertex, typename Allocator, typename OutputIterator>
+	inline void sharded_bfs(const sharded_digraph<Vertex, Allocator>& graph, const Vertex& origin, OutputIterator out)
+	{
+		using graph_type = sharded_digraph<Vertex, Allocator>;
+		using id_type = typename graph_type::id_type;
+		using size_list = std::vector<std::size_t, typename std::allocator_traits<Allocator>::template rebind_alloc<std::size_t>>;
+		using id_list = std::vector<id_type, typename std::allocator_traits<Allocator>::template rebind_alloc<id_type>>;
+		using flag_list = std::vector<char, typename std::allocator_traits<Allocator>::template rebind_alloc<char>>;
+
+		constexpr std::size_t unseen = static_cast<std::size_t>(-1);
+
+		const auto start = graph.locate(origin);
+		if (start.shard == graph_type::npos) {
+			return;
+		}
+
+		struct state
+		{
+			size_list hops;
+			flag_list mailed;
+			id_list frontier;
+			id_list next;
+		};
+		std::vector<state> states(graph.shard_count());
+
+		graph.template run<char>([&](const auto& shard, const auto& inbox, auto& mail, std::size_t level) {
+			auto& own = states[shard.index()];
+			if (level == 0)
+			{
+				own.hops.assign(shard.owned(), unseen);
+				own.mailed.assign(shard.ghost_count(), 0);
+				if (shard.index() == start.shard)
+				{
+					own.hops[start.id] = 0;
+					own.next.push_back(start.id);
+				}
+			}
+
+			own.frontier.swap(own.next);
+			own.next.clear();
+			for (const auto& envelope : inbox)
+			{
+				if (own.hops[envelope.target] == unseen)
+				{
+					own.hops[envelope.target] = level;
+					own.frontier.push_back(envelope.target);
+				}
+			}
+
+			for (const id_type vertex : own.frontier)
+			{
+				for (const id_type target : shard.targets(vertex))
+				{
+					if (shard.is_ghost(target))
+					{
+						auto& mailed = own.mailed[target - shard.owned()];
+						if (!mailed)
+						{
+							mailed = 1;
+							mail.send(target, char(0));
+						}
+					}
+					else if (own.hops[target] == unseen)
+					{
+						own.hops[target] = level + 1;
+						own.next.push_back(target);
+					}
+				}
+			}
+			return !own.next.empty();
+		});
+
+		for (std::size_t s = 0; s < graph.shard_count(); ++s)
+		{
+			const auto& hops = states[s].hops;
+			for (std::size_t id = 0; id < hops.size(); ++id)
+			{
+				if (hops[id] != unseen) {
+					*out++ = std::make_pair(graph[s].key_of(static_cast<id_type>(id)), hops[id]);
+				}
+			}
+		}
+	}
+}
+
+#endif
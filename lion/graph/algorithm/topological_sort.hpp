@@ -1,6 +1,9 @@
 #ifndef LION_GRAPH_TOPOLOGICAL_SORT_HPP
 #define LION_GRAPH_TOPOLOGICAL_SORT_HPP
 
+#include "../graph_traits.hpp"
+
+#include <unordered_map>
 #include <vector>
 #include <cstddef>
 #include <functional>
@@ -14,47 +17,92 @@ namespace lion::graph
 	template<typename Graph, typename OutputIterator, typename Allocator = typename Graph::allocator_type>
 	inline bool topological_sort(const Graph& graph, OutputIterator out)
 	{
-		using vertex_type = typename Graph::vertex_type;
-
-		std::unordered_map<
-			vertex_type,
-			std::size_t,
-			std::hash<vertex_type>,
-			std::equal_to<vertex_type>,
-			typename std::allocator_traits<Allocator>::template rebind_alloc<std::pair<const vertex_type, std::size_t>>
-		> indegrees;
+		if constexpr (is_indexed_graph_v<Graph>)
+		{
+			using id_type = decltype(graph.id_of(std::declval<const typename Graph::vertex_type&>()));
 
-		std::queue<vertex_type, std::deque<vertex_type, Allocator>> queue;
+			const std::size_t bound = graph.id_bound();
 
-		for (const auto& vertex : graph.vertices())
-		{
-			indegrees[vertex] = 0;
+			std::vector<std::size_t, typename std::allocator_traits<Allocator>::template rebind_alloc<std::size_t>> indegrees(bound, 0);
+			std::vector<id_type, typename std::allocator_traits<Allocator>::template rebind_alloc<id_type>> queue;
 
-			for (const auto& edge : graph.edges(vertex)) {
-				++indegrees[edge];
+			for (std::size_t vertex = 0; vertex != bound; ++vertex)
+			{
+				for (const id_type edge : graph.targets(static_cast<id_type>(vertex))) {
+					++indegrees[edge];
+				}
+			}
+			queue.reserve(bound);
+			for (const auto& vertex : graph.vertices())
+			{
+				const auto id = graph.id_of(vertex);
+				if (indegrees[id] == 0) {
+					queue.push_back(id);
+				}
 			}
-			if (indegrees[vertex] == 0) {
-				queue.push(vertex);
+
+			for (std::size_t head = 0; head != queue.size(); ++head)
+			{
+				const id_type vertex = queue[head];
+				*out++ = graph.key_of(vertex);
+
+				for (const id_type edge : graph.targets(vertex))
+				{
+					if (--indegrees[edge] == 0) {
+						queue.push_back(edge);
+					}
+				}
 			}
-		}
 
-		std::size_t count = 0;
-		while (!queue.empty())
+			return queue.size() == graph.vertex_count();
+		}
+		else
 		{
-			vertex_type vertex = queue.front();
-			queue.pop();
-			*out++ = vertex;
+			using vertex_type = typename Graph::vertex_type;
+
+			std::unordered_map<
+				vertex_type,
+				std::size_t,
+				std::hash<vertex_type>,
+				std::equal_to<vertex_type>,
+				typename std::allocator_traits<Allocator>::template rebind_alloc<std::pair<const vertex_type, std::size_t>>
+			> indegrees;
 
-			for (const auto& edge : graph.edges(vertex))
+			std::queue<vertex_type, std::deque<vertex_type, Allocator>> queue;
+
+			for (const auto& vertex : graph.vertices())
 			{
-				if (--indegrees[edge] == 0) {
-					queue.push(edge);
+				indegrees.insert({ vertex, 0 });
+
+				for (const auto& edge : graph.edges(vertex)) {
+					++indegrees[edge];
 				}
 			}
-			++count;
-		}
+			for (const auto& vertex : graph.vertices())
+			{
+				if (indegrees[vertex] == 0) {
+					queue.push(vertex);
+				}
+			}
+
+			std::size_t count = 0;
+			while (!queue.empty())
+			{
+				vertex_type vertex = queue.front();
+				queue.pop();
+				*out++ = vertex;
 
-		return count == graph.vertex_count();
+				for (const auto& edge : graph.edges(vertex))
+				{
+					if (--indegrees[edge] == 0) {
+						queue.push(edge);
+					}
+				}
+				++count;
+			}
+
+			return count == graph.vertex_count();
+		}
 	}
 }
 
@@ -0,0 +1,194 @@
+#ifndef LION_GRAPH_TRIANGLES_HPP
+#define LION_GRAPH_TRIANGLES_HPP
+
+#include "../graph_traits.hpp"
+#include "../digraph.hpp"
+#include "../csr.hpp"
+
+#include <unordered_set>
+#include <functional>
+#include <vector>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <iterator>
+#include <numeric>
+#include <algorithm>
+
+namespace lion::graph
+{
+	// writes every vertex that both x and y have an edge to, once each
+	template<typename Graph, typename OutputIterator, typename Allocator = typename Graph::allocator_type>
+	inline void common_neighbors(const Graph& graph, const typename Graph::vertex_type& x,
+		const typename Graph::vertex_type& y, OutputIterator out)
+	{
+		if constexpr (is_indexed_graph_v<Graph>)
+		{
+			using id_type = decltype(graph.id_of(x));
+			using id_list = std::vector<id_type, typename std::allocator_traits<Allocator>::template rebind_alloc<id_type>>;
+
+			// both rows ascending, parallel edges repeat a target so every copy
+			// of a common one is stepped over at once
+			const auto merge = [&graph, &out](const auto& lhs, const auto& rhs) {
+				auto l = lhs.begin();
+				auto r = rhs.begin();
+				const auto l_last = lhs.end();
+				const auto r_last = rhs.end();
+				while (l != l_last && r != r_last)
+				{
+					if (*l < *r) {
+						++l;
+					}
+					else if (*r < *l) {
+						++r;
+					}
+					else
+					{
+						const id_type common = *l;
+						*out++ = graph.key_of(common);
+						while (l != l_last && *l == common) {
+							++l;
+						}
+						while (r != r_last && *r == common) {
+							++r;
+						}
+					}
+				}
+			};
+
+			const id_type idx = graph.id_of(x);
+			const id_type idy = graph.id_of(y);
+
+			bool sorted = false;
+			if constexpr (has_sorted_rows_v<Graph>) {
+				sorted = graph.rows_sorted();
+			}
+			if (sorted) {
+				merge(graph.targets(idx), graph.targets(idy));
+			}
+			else
+			{
+				const auto targets_of = [&graph](id_type id) {
+					const auto targets = graph.targets(id);
+					id_list list(targets.begin(), targets.end());
+					std::sort(list.begin(), list.end());
+					return list;
+				};
+				merge(targets_of(idx), targets_of(idy));
+			}
+		}
+		else
+		{
+			using vertex_type = typename Graph::vertex_type;
+			using vertex_set = std::unordered_set<vertex_type, std::hash<vertex_type>, std::equal_to<vertex_type>, Allocator>;
+
+			vertex_set lhs;
+			for (const auto& edge : graph.edges(x)) {
+				lhs.insert(static_cast<const vertex_type&>(edge));
+			}
+			for (const auto& edge : graph.edges(y))
+			{
+				// erasing on a hit keeps parallel edges from reporting twice
+				const auto find = lhs.find(static_cast<const vertex_type&>(edge));
+				if (find != lhs.end())
+				{
+					*out++ = *find;
+					lhs.erase(find);
+				}
+			}
+		}
+	}
+
+	// number of triangles in the graph with edge directions, weights, self loops
+	// and parallel edges ignored. every edge is pointed at the endpoint of higher
+	// degree so each triangle is found exactly once, from its lowest ranked corner,
+	// and no vertex has to intersect more than sqrt(2m) targets
+	template<typename Graph, typename Allocator = typename Graph::allocator_type>
+	inline std::size_t triangle_count(const Graph& graph)
+	{
+		if constexpr (is_indexed_graph_v<Graph>)
+		{
+			using id_type = decltype(graph.id_of(std::declval<const typename Graph::vertex_type&>()));
+			using id_list = std::vector<id_type, typename std::allocator_traits<Allocator>::template rebind_alloc<id_type>>;
+			using size_list = std::vector<std::size_t, typename std::allocator_traits<Allocator>::template rebind_alloc<std::size_t>>;
+
+			std::vector<std::pair<id_type, id_type>,
+				typename std::allocator_traits<Allocator>::template rebind_alloc<std::pair<id_type, id_type>>> pairs;
+			for (const auto& vertex : graph.vertices())
+			{
+				const id_type id = graph.id_of(vertex);
+				for (const id_type target : graph.targets(id))
+				{
+					if (target != id)
+					{
+						pairs.emplace_back(id, target);
+						pairs.emplace_back(target, id);
+					}
+				}
+			}
+			std::sort(pairs.begin(), pairs.end());
+			pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+			const std::size_t bound = graph.id_bound();
+
+			size_list degrees(bound, 0);
+			for (const auto& pair : pairs) {
+				++degrees[pair.first];
+			}
+			const auto below = [&degrees](id_type lhs, id_type rhs) {
+				return degrees[lhs] != degrees[rhs] ? degrees[lhs] < degrees[rhs] : lhs < rhs;
+			};
+
+			// pairs are ordered by source then target, so every row comes out sorted
+			size_list offsets(bound + 1, 0);
+			id_list targets;
+			targets.reserve(pairs.size() / 2);
+			for (const auto& pair : pairs)
+			{
+				if (below(pair.first, pair.second))
+				{
+					++offsets[pair.first + 1];
+					targets.push_back(pair.second);
+				}
+			}
+			std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+			std::size_t result = 0;
+			for (std::size_t u = 0; u < bound; ++u)
+			{
+				const auto first = targets.begin() + offsets[u];
+				const auto last = targets.begin() + offsets[u + 1];
+				for (auto v = first; v != last; ++v)
+				{
+					auto l = first;
+					auto r = targets.begin() + offsets[*v];
+					const auto r_last = targets.begin() + offsets[*v + 1];
+					while (l != last && r != r_last)
+					{
+						if (*l < *r) {
+							++l;
+						}
+						else if (*r < *l) {
+							++r;
+						}
+						else
+						{
+							++result;
+							++l;
+							++r;
+						}
+					}
+				}
+			}
+			return result;
+		}
+		else
+		{
+			digraph<typename Graph::vertex_type, csr, Allocator> frozen;
+			frozen.assign(graph);
+			return triangle_count<decltype(frozen), Allocator>(frozen);
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef LION_GRAPH_BIDIRECTIONAL_LIST_HPP
+#define LION_GRAPH_BIDIRECTIONAL_LIST_HPP
+
+#include "bidirectional_list/bidirectional_list_unweighted.hpp"
+#include "bidirectional_list/bidirectional_list_weighted.hpp"
+#include "bidirectional_list/bilist_vertex_iterator.hpp"
+#include "bidirectional_list/bilist_edge_iterator.hpp"
+
+#endif
@@ -0,0 +1,339 @@
+#ifndef LION_GRAPH_BIDIRECTIONAL_LIST_WEIGHTED_HPP
+#define LION_GRAPH_BIDIRECTIONAL_LIST_WEIGHTED_HPP
+
+#include "../../range.hpp"
+#include "../vertex_interner.hpp"
+
+#include <type_traits>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+namespace lion::graph
+{
+	template<typename Weighted, typename... Ts>
+	class bidirectional_list;
+
+	// both directions carry the weight, kept in lists parallel to the ids
+	template<typename Vertex, typename Weight, typename Allocator>
+	class bidirectional_list<std::true_type, Vertex, Weight, Allocator>
+	{
+	protected:
+		using vertex_type	 = Vertex;
+		using weight_type	 = Weight;
+		using allocator_type = Allocator;
+
+		struct edge_type
+		{
+			vertex_type first;
+			vertex_type second;
+			weight_type weight;
+		};
+
+	private:
+		using id_type = vertex_id;
+
+		using vertices_list = vertex_interner<vertex_type, id_type, allocator_type>;
+
+		using id_list = std::vector<
+			id_type,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<id_type>
+		>;
+
+		using weight_list = std::vector<
+			weight_type,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<weight_type>
+		>;
+
+		struct node
+		{
+			id_list out;
+			weight_list out_weights;
+			id_list in;
+			weight_list in_weights;
+		};
+
+		using node_list = std::vector<
+			node,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<node>
+		>;
+
+		vertices_list vertices;
+		node_list nodes;
+		std::size_t edges = 0;
+
+	protected:
+		using size_type		  = typename vertices_list::size_type;
+		using difference_type = std::ptrdiff_t;
+
+		class vertex_iterator;
+		class edge_iterator;
+
+		explicit bidirectional_list(const allocator_type& alloc = allocator_type{})
+			: vertices(alloc), nodes(alloc)
+		{}
+
+	private:
+		template<typename V>
+		id_type intern(V&& vertex)
+		{
+			auto&&[id, succ] = vertices.insert(std::forward<V>(vertex));
+			if (succ) {
+				nodes.push_back({
+					id_list(get_allocator()), weight_list(get_allocator()),
+					id_list(get_allocator()), weight_list(get_allocator())
+				});
+			}
+			return id;
+		}
+
+		void link(id_type x, id_type y, const weight_type& weight)
+		{
+			nodes[x].out.push_back(y);
+			nodes[x].out_weights.push_back(weight);
+			nodes[y].in.push_back(x);
+			nodes[y].in_weights.push_back(weight);
+			++edges;
+		}
+
+		// erases up to count entries equal to id along with their weights,
+		// returns how many were erased
+		static std::size_t unlink(id_list& list, weight_list& weights, id_type id, std::size_t count = std::size_t(-1))
+		{
+			std::size_t removed = 0;
+			std::size_t kept = 0;
+			for (std::size_t i = 0; i < list.size(); ++i)
+			{
+				if (list[i] == id && removed < count)
+				{
+					++removed;
+					continue;
+				}
+				list[kept] = list[i];
+				weights[kept] = std::move(weights[i]);
+				++kept;
+			}
+			list.erase(list.begin() + kept, list.end());
+			weights.erase(weights.begin() + kept, weights.end());
+			return removed;
+		}
+
+	public:
+		void add_edge(const edge_type& edge)
+		{
+			const auto x = intern(edge.first);
+			link(x, intern(edge.second), edge.weight);
+		}
+
+		void add_edge(edge_type&& edge)
+		{
+			const auto x = intern(std::move(edge.first));
+			link(x, intern(std::move(edge.second)), edge.weight);
+		}
+
+		template<typename ForwardIterator>
+		void add_edges(ForwardIterator first, ForwardIterator last)
+		{
+			for (; first != last; ++first) {
+				add_edge(*first);
+			}
+		}
+
+		void add_vertex(const vertex_type& vertex) { intern(vertex); }
+		void add_vertex(vertex_type&& vertex)      { intern(std::move(vertex)); }
+
+		void remove_edge(const edge_type& edge)
+		{
+			const auto x = vertices.id_of(edge.first);
+			const auto y = vertices.id_of(edge.second);
+
+			const auto removed = unlink(nodes[x].out, nodes[x].out_weights, y);
+			unlink(nodes[y].in, nodes[y].in_weights, x, removed);
+			edges -= removed;
+		}
+
+		// only the lists of the neighbors are touched
+		void remove_vertex(const vertex_type& vertex)
+		{
+			const auto id = vertices.id_of(vertex);
+			auto& self = nodes[id];
+
+			for (const auto target : self.out)
+			{
+				if (target != id) {
+					unlink(nodes[target].in, nodes[target].in_weights, id, 1);
+				}
+			}
+			edges -= self.out.size();
+
+			for (const auto source : self.in)
+			{
+				if (source != id)
+				{
+					unlink(nodes[source].out, nodes[source].out_weights, id, 1);
+					--edges;
+				}
+			}
+
+			self.out.clear();
+			self.out_weights.clear();
+			self.in.clear();
+			self.in_weights.clear();
+			vertices.erase(id);
+		}
+
+		// renumbers the vertices densely, dropping the slots of removed vertices
+		void compact()
+		{
+			const auto remap = vertices.compact();
+
+			std::size_t next = 0;
+			for (std::size_t id = 0; id < remap.size(); ++id)
+			{
+				if (remap[id] == vertices_list::npos) {
+					continue;
+				}
+				auto& current = nodes[id];
+				for (auto& target : current.out) {
+					target = remap[target];
+				}
+				for (auto& source : current.in) {
+					source = remap[source];
+				}
+				if (next != id) {
+					nodes[next] = std::move(current);
+				}
+				++next;
+			}
+			nodes.erase(nodes.begin() + next, nodes.end());
+		}
+
+		bool contains(const vertex_type& vertex) const {
+			return vertices.contains(vertex);
+		}
+
+		vertex_iterator get(const vertex_type& vertex) const {
+			return vertex_iterator(vertices.find(vertex));
+		}
+
+		// weight, if given, receives the weight of the last matching edge
+		size_type adjacent(const vertex_type& x, const vertex_type& y, weight_type* weight) const
+		{
+			const auto& from = nodes[vertices.id_of(x)];
+			const auto idy = vertices.id_of(y);
+
+			size_type result = 0;
+			for (std::size_t i = 0; i < from.out.size(); ++i)
+			{
+				if (from.out[i] == idy)
+				{
+					if (weight) {
+						*weight = from.out_weights[i];
+					}
+					++result;
+				}
+			}
+			return result;
+		}
+
+		size_type degree(const vertex_type& vertex) const { return nodes[vertices.id_of(vertex)].out.size(); }
+		size_type in_degree(const vertex_type& vertex) const { return nodes[vertices.id_of(vertex)].in.size(); }
+
+		size_type vertex_count() const noexcept { return vertices.size(); }
+		size_type edge_count()   const noexcept { return edges; }
+
+		id_type id_of(const vertex_type& vertex) const { return vertices.id_of(vertex); }
+		const vertex_type& key_of(id_type id) const { return vertices.key_of(id); }
+		size_type id_bound() const noexcept { return vertices.bound(); }
+
+		range<const id_type*> targets(id_type id) const noexcept {
+			return { nodes[id].out.data(), nodes[id].out.data() + nodes[id].out.size() };
+		}
+
+		range<const id_type*> sources(id_type id) const noexcept {
+			return { nodes[id].in.data(), nodes[id].in.data() + nodes[id].in.size() };
+		}
+
+		// parallel to targets(id) and sources(id)
+		range<const weight_type*> weights(id_type id) const noexcept {
+			return { nodes[id].out_weights.data(), nodes[id].out_weights.data() + nodes[id].out_weights.size() };
+		}
+
+		range<const weight_type*> source_weights(id_type id) const noexcept {
+			return { nodes[id].in_weights.data(), nodes[id].in_weights.data() + nodes[id].in_weights.size() };
+		}
+
+		vertex_iterator begin() const noexcept { return vertex_iterator(vertices.begin()); }
+		vertex_iterator end()   const noexcept { return vertex_iterator(vertices.end()); }
+
+		edge_iterator begin(const vertex_type& vert) const noexcept
+		{
+			const auto& n = nodes[vertices.id_of(vert)];
+			return edge_iterator(n.out.data(), n.out_weights.data(), vertices);
+		}
+		edge_iterator end(const vertex_type& vert) const noexcept
+		{
+			const auto& n = nodes[vertices.id_of(vert)];
+			return edge_iterator(n.out.data() + n.out.size(), n.out_weights.data() + n.out.size(), vertices);
+		}
+
+		// the vertices with an edge to vert, with the weight of that edge
+		edge_iterator in_begin(const vertex_type& vert) const noexcept
+		{
+			const auto& n = nodes[vertices.id_of(vert)];
+			return edge_iterator(n.in.data(), n.in_weights.data(), vertices);
+		}
+		edge_iterator in_end(const vertex_type& vert) const noexcept
+		{
+			const auto& n = nodes[vertices.id_of(vert)];
+			return edge_iterator(n.in.data() + n.in.size(), n.in_weights.data() + n.in.size(), vertices);
+		}
+
+		range<edge_iterator> in_edges(const vertex_type& vert) const noexcept {
+			return { in_begin(vert), in_end(vert) };
+		}
+
+		friend bool operator==(const bidirectional_list& lhs, const bidirectional_list& rhs)
+		{
+			if (lhs.vertices != rhs.vertices || lhs.edges != rhs.edges) {
+				return false;
+			}
+			for (auto it = lhs.vertices.begin(); it != lhs.vertices.end(); ++it)
+			{
+				const auto& a = lhs.nodes[it.id()];
+				const auto& b = rhs.nodes[rhs.vertices.id_of(*it)];
+
+				if (a.out.size() != b.out.size()) {
+					return false;
+				}
+				for (std::size_t i = 0; i < a.out.size(); ++i)
+				{
+					if (!(lhs.vertices.key_of(a.out[i]) == rhs.vertices.key_of(b.out[i])) ||
+						!(a.out_weights[i] == b.out_weights[i])) {
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+		friend bool operator!=(const bidirectional_list& lhs, const bidirectional_list& rhs) {
+			return !(lhs == rhs);
+		}
+
+		void swap(bidirectional_list& rhs) noexcept(
+			noexcept(std::swap(vertices, rhs.vertices)) &&
+			noexcept(std::swap(nodes, rhs.nodes)))
+		{
+			std::swap(vertices, rhs.vertices);
+			std::swap(nodes, rhs.nodes);
+			std::swap(edges, rhs.edges);
+		}
+
+		allocator_type get_allocator() const { return vertices.get_allocator(); }
+	};
+}
+
+#endif
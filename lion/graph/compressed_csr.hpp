@@ -0,0 +1,9 @@
+#ifndef LION_GRAPH_COMPRESSED_CSR_HPP
+#define LION_GRAPH_COMPRESSED_CSR_HPP
+
+#include "compressed_csr/compressed_csr_unweighted.hpp"
+#include "compressed_csr/compressed_csr_weighted.hpp"
+#include "compressed_csr/ccsr_vertex_iterator.hpp"
+#include "compressed_csr/ccsr_edge_iterator.hpp"
+
+#endif
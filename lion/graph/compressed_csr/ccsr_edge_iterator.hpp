@@ -0,0 +1,132 @@
+#ifndef LION_GRAPH_CCSR_EDGE_ITERATOR_HPP
+#define LION_GRAPH_CCSR_EDGE_ITERATOR_HPP
+
+#include "compressed_csr_unweighted.hpp"
+#include "compressed_csr_weighted.hpp"
+
+#include <type_traits>
+#include <iterator>
+#include <memory>
+
+namespace lion::graph
+{
+	// unweighted
+	template<typename Vertex, typename Weight, typename Allocator>
+	class compressed_csr<std::false_type, Vertex, Weight, Allocator>::edge_iterator
+	{
+	private:
+		template<typename Weighted, typename... Ts>
+		friend class compressed_csr;
+
+		using list = compressed_csr<std::false_type, Vertex, Weight, Allocator>;
+
+		typename list::row_iterator current;
+		const typename list::vertices_list* vertices;
+
+		edge_iterator(decltype(current) curr, const typename list::vertices_list& verts)
+			: current(curr), vertices(std::addressof(verts))
+		{}
+
+	public:
+		using value_type		= typename list::vertex_type;
+		using reference			= const value_type&;
+		using pointer			= const value_type*;
+		using difference_type	= std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+
+		edge_iterator() = default;
+		edge_iterator(const edge_iterator&) = default;
+		edge_iterator& operator=(const edge_iterator&) = default;
+
+		edge_iterator& operator++()
+		{
+			++current;
+			return *this;
+		}
+
+		edge_iterator operator++(int)
+		{
+			edge_iterator temp(*this);
+			++current;
+			return temp;
+		}
+
+		reference operator*() const { return vertices->key_of(*current); }
+		pointer operator->()  const { return std::addressof(vertices->key_of(*current)); }
+
+		friend bool operator==(const edge_iterator& lhs, const edge_iterator& rhs) {
+			return lhs.current == rhs.current;
+		}
+		friend bool operator!=(const edge_iterator& lhs, const edge_iterator& rhs) {
+			return !(lhs == rhs);
+		}
+	};
+
+	// weighted
+	template<typename Vertex, typename Weight, typename Allocator>
+	class compressed_csr<std::true_type, Vertex, Weight, Allocator>::edge_iterator
+	{
+	private:
+		template<typename Weighted, typename... Ts>
+		friend class compressed_csr;
+
+		using list = compressed_csr<std::true_type, Vertex, Weight, Allocator>;
+
+		typename list::row_iterator current;
+		const typename list::weight_type* weight;
+		const typename list::vertices_list* vertices;
+
+		edge_iterator(decltype(current) curr, decltype(weight) w, const typename list::vertices_list& verts)
+			: current(curr), weight(w), vertices(std::addressof(verts))
+		{}
+
+	public:
+		struct value_type
+		{
+			const typename list::vertex_type& second;
+			const typename list::weight_type& weight;
+
+			operator const typename list::vertex_type&() const { return second; }
+		};
+
+		struct pointer
+		{
+			value_type value;
+			const value_type* operator->() const { return std::addressof(value); }
+		};
+
+		using reference			= value_type;
+		using difference_type	= std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+
+		edge_iterator() = default;
+		edge_iterator(const edge_iterator&) = default;
+		edge_iterator& operator=(const edge_iterator&) = default;
+
+		edge_iterator& operator++()
+		{
+			++current;
+			++weight;
+			return *this;
+		}
+
+		edge_iterator operator++(int)
+		{
+			edge_iterator temp(*this);
+			++*this;
+			return temp;
+		}
+
+		reference operator*() const { return { vertices->key_of(*current), *weight }; }
+		pointer operator->()  const { return { operator*() }; }
+
+		friend bool operator==(const edge_iterator& lhs, const edge_iterator& rhs) {
+			return lhs.current == rhs.current;
+		}
+		friend bool operator!=(const edge_iterator& lhs, const edge_iterator& rhs) {
+			return !(lhs == rhs);
+		}
+	};
+}
+
+#endif
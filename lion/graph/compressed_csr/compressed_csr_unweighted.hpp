@@ -0,0 +1,309 @@
+#ifndef LION_GRAPH_COMPRESSED_CSR_UNWEIGHTED_HPP
+#define LION_GRAPH_COMPRESSED_CSR_UNWEIGHTED_HPP
+
+#include "../../range.hpp"
+#include "../vertex_interner.hpp"
+#include "../detail/varint.hpp"
+
+#include <type_traits>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <iterator>
+#include <numeric>
+#include <algorithm>
+
+namespace lion::graph
+{
+	template<typename Weighted, typename... Ts>
+	class compressed_csr;
+
+	// csr whose rows are sorted and gap encoded as varints, a row of vertex i
+	// is bytes[offsets[i]..offsets[i + 1]]. meant for large read-mostly graphs,
+	// every batch of edges re-encodes only the rows it touches
+	template<typename Vertex, typename Weight, typename Allocator>
+	class compressed_csr<std::false_type, Vertex, Weight, Allocator>
+	{
+	protected:
+		using vertex_type	 = Vertex;
+		using allocator_type = Allocator;
+
+		struct edge_type
+		{
+			vertex_type first;
+			vertex_type second;
+		};
+
+	private:
+		using id_type = vertex_id;
+
+		using vertices_list = vertex_interner<vertex_type, id_type, allocator_type>;
+
+		using offset_list = std::vector<
+			std::size_t,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<std::size_t>
+		>;
+
+		using byte_list = std::vector<
+			unsigned char,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<unsigned char>
+		>;
+
+		using id_list = std::vector<
+			id_type,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<id_type>
+		>;
+
+		using row_iterator = detail::varint_iterator<id_type>;
+
+		vertices_list vertices;
+		offset_list offsets;
+		byte_list bytes;
+		offset_list in_degrees;
+		std::size_t edges = 0;
+
+	protected:
+		using size_type		  = typename vertices_list::size_type;
+		using difference_type = std::ptrdiff_t;
+
+		class vertex_iterator;
+		class edge_iterator;
+
+		explicit compressed_csr(const allocator_type& alloc = allocator_type{})
+			: vertices(alloc), offsets(1, 0, alloc), bytes(alloc), in_degrees(alloc)
+		{}
+
+	private:
+		// a new vertex starts out with an empty row, a single zero count byte
+		id_type intern(const vertex_type& vertex)
+		{
+			auto&&[id, succ] = vertices.insert(vertex);
+			if (succ)
+			{
+				bytes.push_back(0);
+				offsets.push_back(bytes.size());
+				in_degrees.push_back(0);
+			}
+			return id;
+		}
+
+		const unsigned char* row(id_type id) const noexcept { return bytes.data() + offsets[id]; }
+
+		template<typename Pending>
+		void rebuild(const Pending& pending)
+		{
+			const auto n = vertices.bound();
+
+			// pending edges bucketed by source
+			offset_list starts(n + 1, 0, get_allocator());
+			for (auto&&[x, y] : pending)
+			{
+				++starts[x + 1];
+				++in_degrees[y];
+			}
+			std::partial_sum(starts.begin(), starts.end(), starts.begin());
+
+			id_list added(pending.size(), get_allocator());
+			offset_list fill(starts.begin(), std::prev(starts.end()), get_allocator());
+			for (auto&&[x, y] : pending) {
+				added[fill[x]++] = y;
+			}
+
+			offset_list next(n + 1, 0, get_allocator());
+			byte_list merged(get_allocator());
+			merged.reserve(bytes.size() + 2 * pending.size());
+
+			id_list scratch(get_allocator());
+			for (std::size_t v = 0; v < n; ++v)
+			{
+				const auto id = static_cast<id_type>(v);
+				if (starts[v] == starts[v + 1]) {
+					merged.insert(merged.end(), bytes.begin() + offsets[v], bytes.begin() + offsets[v + 1]);
+				}
+				else
+				{
+					scratch.assign(row_iterator(row(id), id), row_iterator(bytes.data() + offsets[v + 1]));
+					scratch.insert(scratch.end(), added.begin() + starts[v], added.begin() + starts[v + 1]);
+					std::sort(scratch.begin(), scratch.end());
+					detail::put_row(merged, id, scratch.data(), scratch.data() + scratch.size());
+				}
+				next[v + 1] = merged.size();
+			}
+
+			offsets.swap(next);
+			bytes.swap(merged);
+			bytes.shrink_to_fit();
+			edges += pending.size();
+		}
+
+	public:
+		template<typename ForwardIterator>
+		void add_edges(ForwardIterator first, ForwardIterator last)
+		{
+			std::vector<
+				std::pair<id_type, id_type>,
+				typename std::allocator_traits<allocator_type>::template rebind_alloc<std::pair<id_type, id_type>>
+			> pending(get_allocator());
+
+			pending.reserve(std::distance(first, last));
+			for (; first != last; ++first)
+			{
+				const auto& edge = *first;
+				const auto x = intern(edge.first);
+				const auto y = intern(edge.second);
+				pending.push_back({ x, y });
+			}
+			rebuild(pending);
+		}
+
+		void add_vertex(const vertex_type& vertex) { intern(vertex); }
+
+		template<typename Graph>
+		void assign(const Graph& graph)
+		{
+			vertices.clear();
+			offsets.assign(1, 0);
+			bytes.clear();
+			in_degrees.clear();
+			edges = 0;
+
+			for (const auto& vertex : graph.vertices()) {
+				intern(vertex);
+			}
+
+			std::vector<
+				std::pair<id_type, id_type>,
+				typename std::allocator_traits<allocator_type>::template rebind_alloc<std::pair<id_type, id_type>>
+			> pending(get_allocator());
+
+			for (std::size_t v = 0; v < vertices.bound(); ++v)
+			{
+				for (const auto& edge : graph.edges(vertices.key_of(v))) {
+					pending.push_back({ static_cast<id_type>(v), vertices.id_of(edge) });
+				}
+			}
+			rebuild(pending);
+		}
+
+		// renumbers the vertices so that order[i] becomes id i and re-encodes
+		// the rows in that order, which also shrinks the gaps when order keeps
+		// neighbours close. vertices missing from order are dropped along with
+		// their edges. returns the old id to new id mapping
+		template<typename Order>
+		typename vertices_list::remap_type permute(const Order& order)
+		{
+			std::vector<
+				std::pair<id_type, id_type>,
+				typename std::allocator_traits<allocator_type>::template rebind_alloc<std::pair<id_type, id_type>>
+			> pending(get_allocator());
+			pending.reserve(edges);
+
+			const auto bound = vertices.bound();
+			const auto remap = vertices.permute(order);
+			for (std::size_t v = 0; v < bound; ++v)
+			{
+				for (const id_type target : targets(static_cast<id_type>(v)))
+				{
+					if (remap[v] != vertices_list::npos && remap[target] != vertices_list::npos) {
+						pending.push_back({ remap[v], remap[target] });
+					}
+				}
+			}
+
+			bytes.assign(vertices.bound(), 0);
+			offsets.resize(vertices.bound() + 1);
+			std::iota(offsets.begin(), offsets.end(), 0);
+			in_degrees.assign(vertices.bound(), 0);
+			edges = 0;
+			rebuild(pending);
+
+			return remap;
+		}
+
+		bool contains(const vertex_type& vertex) const {
+			return vertices.contains(vertex);
+		}
+
+		vertex_iterator get(const vertex_type& vertex) const {
+			return vertex_iterator(vertices.find(vertex));
+		}
+
+		// rows are always kept in id order
+		bool rows_sorted() const noexcept { return true; }
+
+		size_type adjacent(const vertex_type& x, const vertex_type& y) const
+		{
+			const auto idxx = vertices.id_of(x);
+			const auto idxy = vertices.id_of(y);
+
+			size_type result = 0;
+			for (const id_type target : targets(idxx))
+			{
+				if (target > idxy) {
+					break;
+				}
+				result += target == idxy;
+			}
+			return result;
+		}
+
+		size_type vertex_count() const noexcept { return vertices.size(); }
+		size_type edge_count()   const noexcept { return edges; }
+
+		// encoded size of all rows
+		size_type byte_count() const noexcept { return bytes.size(); }
+
+		size_type degree(const vertex_type& vertex) const {
+			return detail::row_count(row(vertices.id_of(vertex)));
+		}
+
+		size_type in_degree(const vertex_type& vertex) const { return in_degrees[vertices.id_of(vertex)]; }
+
+		id_type id_of(const vertex_type& vertex) const { return vertices.id_of(vertex); }
+		const vertex_type& key_of(id_type id) const { return vertices.key_of(id); }
+		size_type id_bound() const noexcept { return vertices.bound(); }
+
+		range<row_iterator> targets(id_type id) const noexcept {
+			return { row_iterator(row(id), id), row_iterator(bytes.data() + offsets[id + 1]) };
+		}
+
+		vertex_iterator begin() const noexcept { return vertex_iterator(vertices.begin()); }
+		vertex_iterator end()   const noexcept { return vertex_iterator(vertices.end()); }
+
+		edge_iterator begin(const vertex_type& vert) const noexcept
+		{
+			const auto index = vertices.id_of(vert);
+			return edge_iterator(row_iterator(row(index), index), vertices);
+		}
+
+		edge_iterator end(const vertex_type& vert) const noexcept
+		{
+			const auto index = vertices.id_of(vert);
+			return edge_iterator(row_iterator(bytes.data() + offsets[index + 1]), vertices);
+		}
+
+		friend bool operator==(const compressed_csr& lhs, const compressed_csr& rhs) {
+			return lhs.vertices == rhs.vertices && lhs.offsets == rhs.offsets && lhs.bytes == rhs.bytes;
+		}
+		friend bool operator!=(const compressed_csr& lhs, const compressed_csr& rhs) {
+			return !(lhs == rhs);
+		}
+
+		void swap(compressed_csr& rhs) noexcept(
+			noexcept(std::swap(vertices, rhs.vertices)) &&
+			noexcept(std::swap(offsets, rhs.offsets)) &&
+			noexcept(std::swap(bytes, rhs.bytes)))
+		{
+			std::swap(vertices, rhs.vertices);
+			std::swap(offsets, rhs.offsets);
+			std::swap(bytes, rhs.bytes);
+			std::swap(in_degrees, rhs.in_degrees);
+			std::swap(edges, rhs.edges);
+		}
+
+		allocator_type get_allocator() const { return vertices.get_allocator(); }
+	};
+}
+
+#endif
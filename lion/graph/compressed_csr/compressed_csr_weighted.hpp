@@ -0,0 +1,373 @@
+#ifndef LION_GRAPH_COMPRESSED_CSR_WEIGHTED_HPP
+#define LION_GRAPH_COMPRESSED_CSR_WEIGHTED_HPP
+
+#include "../../range.hpp"
+#include "../vertex_interner.hpp"
+#include "../detail/varint.hpp"
+
+#include <type_traits>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <iterator>
+#include <numeric>
+#include <algorithm>
+
+namespace lion::graph
+{
+	template<typename Weighted, typename... Ts>
+	class compressed_csr;
+
+	// weights stay uncompressed in their own array, the weights of the row of
+	// vertex i are values[first_edges[i]..first_edges[i + 1]] in target order
+	template<typename Vertex, typename Weight, typename Allocator>
+	class compressed_csr<std::true_type, Vertex, Weight, Allocator>
+	{
+	protected:
+		using vertex_type	 = Vertex;
+		using weight_type	 = Weight;
+		using allocator_type = Allocator;
+
+		struct edge_type
+		{
+			vertex_type first;
+			vertex_type second;
+			weight_type weight;
+		};
+
+	private:
+		using id_type = vertex_id;
+
+		using vertices_list = vertex_interner<vertex_type, id_type, allocator_type>;
+
+		using offset_list = std::vector<
+			std::size_t,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<std::size_t>
+		>;
+
+		using byte_list = std::vector<
+			unsigned char,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<unsigned char>
+		>;
+
+		using id_list = std::vector<
+			id_type,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<id_type>
+		>;
+
+		using value_list = std::vector<
+			weight_type,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<weight_type>
+		>;
+
+		using row_iterator = detail::varint_iterator<id_type>;
+
+		vertices_list vertices;
+		offset_list offsets;
+		byte_list bytes;
+		offset_list first_edges;
+		value_list values;
+		offset_list in_degrees;
+
+	protected:
+		using size_type		  = typename vertices_list::size_type;
+		using difference_type = std::ptrdiff_t;
+
+		class vertex_iterator;
+		class edge_iterator;
+
+		explicit compressed_csr(const allocator_type& alloc = allocator_type{})
+			: vertices(alloc), offsets(1, 0, alloc), bytes(alloc), first_edges(1, 0, alloc), values(alloc), in_degrees(alloc)
+		{}
+
+	private:
+		// a new vertex starts out with an empty row, a single zero count byte
+		id_type intern(const vertex_type& vertex)
+		{
+			auto&&[id, succ] = vertices.insert(vertex);
+			if (succ)
+			{
+				bytes.push_back(0);
+				offsets.push_back(bytes.size());
+				first_edges.push_back(first_edges.back());
+				in_degrees.push_back(0);
+			}
+			return id;
+		}
+
+		const unsigned char* row(id_type id) const noexcept { return bytes.data() + offsets[id]; }
+
+		struct pending_edge
+		{
+			id_type first;
+			id_type second;
+			weight_type weight;
+		};
+
+		template<typename Pending>
+		void rebuild(Pending& pending)
+		{
+			const auto n = vertices.bound();
+
+			// pending edges bucketed by source, stable so that parallel edges
+			// keep the order they were added in
+			offset_list starts(n + 1, 0, get_allocator());
+			for (auto&& edge : pending)
+			{
+				++starts[edge.first + 1];
+				++in_degrees[edge.second];
+			}
+			std::partial_sum(starts.begin(), starts.end(), starts.begin());
+
+			offset_list order(pending.size(), get_allocator());
+			offset_list fill(starts.begin(), std::prev(starts.end()), get_allocator());
+			for (std::size_t i = 0; i < pending.size(); ++i) {
+				order[fill[pending[i].first]++] = i;
+			}
+
+			offset_list next(n + 1, 0, get_allocator());
+			offset_list next_edges(n + 1, 0, get_allocator());
+			byte_list merged(get_allocator());
+			value_list merged_values(get_allocator());
+			merged.reserve(bytes.size() + 2 * pending.size());
+			merged_values.reserve(values.size() + pending.size());
+
+			std::vector<
+				std::pair<id_type, weight_type>,
+				typename std::allocator_traits<allocator_type>::template rebind_alloc<std::pair<id_type, weight_type>>
+			> scratch(get_allocator());
+			id_list ids(get_allocator());
+
+			for (std::size_t v = 0; v < n; ++v)
+			{
+				const auto id = static_cast<id_type>(v);
+				if (starts[v] == starts[v + 1])
+				{
+					merged.insert(merged.end(), bytes.begin() + offsets[v], bytes.begin() + offsets[v + 1]);
+					std::move(values.begin() + first_edges[v], values.begin() + first_edges[v + 1], std::back_inserter(merged_values));
+				}
+				else
+				{
+					scratch.clear();
+					auto weight = values.begin() + first_edges[v];
+					for (const id_type target : targets(id)) {
+						scratch.emplace_back(target, std::move(*weight++));
+					}
+					for (auto i = starts[v]; i != starts[v + 1]; ++i) {
+						scratch.emplace_back(pending[order[i]].second, std::move(pending[order[i]].weight));
+					}
+					std::stable_sort(scratch.begin(), scratch.end(), [](const auto& lhs, const auto& rhs) {
+						return lhs.first < rhs.first;
+					});
+
+					ids.clear();
+					for (auto& [target, value] : scratch)
+					{
+						ids.push_back(target);
+						merged_values.push_back(std::move(value));
+					}
+					detail::put_row(merged, id, ids.data(), ids.data() + ids.size());
+				}
+				next[v + 1] = merged.size();
+				next_edges[v + 1] = merged_values.size();
+			}
+
+			offsets.swap(next);
+			bytes.swap(merged);
+			bytes.shrink_to_fit();
+			first_edges.swap(next_edges);
+			values.swap(merged_values);
+		}
+
+	public:
+		template<typename ForwardIterator>
+		void add_edges(ForwardIterator first, ForwardIterator last)
+		{
+			std::vector<
+				pending_edge,
+				typename std::allocator_traits<allocator_type>::template rebind_alloc<pending_edge>
+			> pending(get_allocator());
+
+			pending.reserve(std::distance(first, last));
+			for (; first != last; ++first)
+			{
+				const auto& edge = *first;
+				const auto x = intern(edge.first);
+				const auto y = intern(edge.second);
+				pending.push_back({ x, y, edge.weight });
+			}
+			rebuild(pending);
+		}
+
+		void add_vertex(const vertex_type& vertex) { intern(vertex); }
+
+		template<typename Graph>
+		void assign(const Graph& graph)
+		{
+			vertices.clear();
+			offsets.assign(1, 0);
+			bytes.clear();
+			first_edges.assign(1, 0);
+			values.clear();
+			in_degrees.clear();
+
+			for (const auto& vertex : graph.vertices()) {
+				intern(vertex);
+			}
+
+			std::vector<
+				pending_edge,
+				typename std::allocator_traits<allocator_type>::template rebind_alloc<pending_edge>
+			> pending(get_allocator());
+
+			for (std::size_t v = 0; v < vertices.bound(); ++v)
+			{
+				for (const auto& edge : graph.edges(vertices.key_of(v))) {
+					pending.push_back({ static_cast<id_type>(v), vertices.id_of(edge), static_cast<const weight_type&>(edge.weight) });
+				}
+			}
+			rebuild(pending);
+		}
+
+		// renumbers the vertices so that order[i] becomes id i and re-encodes
+		// the rows in that order, which also shrinks the gaps when order keeps
+		// neighbours close. vertices missing from order are dropped along with
+		// their edges. returns the old id to new id mapping
+		template<typename Order>
+		typename vertices_list::remap_type permute(const Order& order)
+		{
+			std::vector<
+				pending_edge,
+				typename std::allocator_traits<allocator_type>::template rebind_alloc<pending_edge>
+			> pending(get_allocator());
+			pending.reserve(values.size());
+
+			const auto bound = vertices.bound();
+			const auto remap = vertices.permute(order);
+			for (std::size_t v = 0; v < bound; ++v)
+			{
+				auto weight = values.begin() + first_edges[v];
+				for (const id_type target : targets(static_cast<id_type>(v)))
+				{
+					if (remap[v] != vertices_list::npos && remap[target] != vertices_list::npos) {
+						pending.push_back({ remap[v], remap[target], std::move(*weight) });
+					}
+					++weight;
+				}
+			}
+
+			bytes.assign(vertices.bound(), 0);
+			offsets.resize(vertices.bound() + 1);
+			std::iota(offsets.begin(), offsets.end(), 0);
+			first_edges.assign(vertices.bound() + 1, 0);
+			values.clear();
+			in_degrees.assign(vertices.bound(), 0);
+			rebuild(pending);
+
+			return remap;
+		}
+
+		bool contains(const vertex_type& vertex) const {
+			return vertices.contains(vertex);
+		}
+
+		vertex_iterator get(const vertex_type& vertex) const {
+			return vertex_iterator(vertices.find(vertex));
+		}
+
+		// rows are always kept in id order
+		bool rows_sorted() const noexcept { return true; }
+
+		// the weight of the last edge added between x and y is reported
+		size_type adjacent(const vertex_type& x, const vertex_type& y, weight_type* weight) const
+		{
+			const auto idxx = vertices.id_of(x);
+			const auto idxy = vertices.id_of(y);
+
+			size_type result = 0;
+			auto position = first_edges[idxx];
+			for (const id_type target : targets(idxx))
+			{
+				if (target > idxy) {
+					break;
+				}
+				if (target == idxy)
+				{
+					++result;
+
+					if (weight) {
+						*weight = values[position];
+					}
+				}
+				++position;
+			}
+			return result;
+		}
+
+		size_type vertex_count() const noexcept { return vertices.size(); }
+		size_type edge_count()   const noexcept { return values.size(); }
+
+		// encoded size of all rows
+		size_type byte_count() const noexcept { return bytes.size(); }
+
+		size_type degree(const vertex_type& vertex) const {
+			return detail::row_count(row(vertices.id_of(vertex)));
+		}
+
+		size_type in_degree(const vertex_type& vertex) const { return in_degrees[vertices.id_of(vertex)]; }
+
+		id_type id_of(const vertex_type& vertex) const { return vertices.id_of(vertex); }
+		const vertex_type& key_of(id_type id) const { return vertices.key_of(id); }
+		size_type id_bound() const noexcept { return vertices.bound(); }
+
+		range<row_iterator> targets(id_type id) const noexcept {
+			return { row_iterator(row(id), id), row_iterator(bytes.data() + offsets[id + 1]) };
+		}
+
+		// parallel to targets(id)
+		range<const weight_type*> weights(id_type id) const noexcept {
+			return { values.data() + first_edges[id], values.data() + first_edges[id + 1] };
+		}
+
+		vertex_iterator begin() const noexcept { return vertex_iterator(vertices.begin()); }
+		vertex_iterator end()   const noexcept { return vertex_iterator(vertices.end()); }
+
+		edge_iterator begin(const vertex_type& vert) const noexcept
+		{
+			const auto index = vertices.id_of(vert);
+			return edge_iterator(row_iterator(row(index), index), values.data() + first_edges[index], vertices);
+		}
+
+		edge_iterator end(const vertex_type& vert) const noexcept
+		{
+			const auto index = vertices.id_of(vert);
+			return edge_iterator(row_iterator(bytes.data() + offsets[index + 1]), values.data() + first_edges[index + 1], vertices);
+		}
+
+		friend bool operator==(const compressed_csr& lhs, const compressed_csr& rhs) {
+			return lhs.vertices == rhs.vertices && lhs.offsets == rhs.offsets && lhs.bytes == rhs.bytes && lhs.values == rhs.values;
+		}
+		friend bool operator!=(const compressed_csr& lhs, const compressed_csr& rhs) {
+			return !(lhs == rhs);
+		}
+
+		void swap(compressed_csr& rhs) noexcept(
+			noexcept(std::swap(vertices, rhs.vertices)) &&
+			noexcept(std::swap(offsets, rhs.offsets)) &&
+			noexcept(std::swap(bytes, rhs.bytes)) &&
+			noexcept(std::swap(values, rhs.values)))
+		{
+			std::swap(vertices, rhs.vertices);
+			std::swap(offsets, rhs.offsets);
+			std::swap(bytes, rhs.bytes);
+			std::swap(first_edges, rhs.first_edges);
+			std::swap(values, rhs.values);
+			std::swap(in_degrees, rhs.in_degrees);
+		}
+
+		allocator_type get_allocator() const { return vertices.get_allocator(); }
+	};
+}
+
+#endif
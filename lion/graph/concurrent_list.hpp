@@ -0,0 +1,10 @@
+#ifndef LION_GRAPH_CONCURRENT_LIST_HPP
+#define LION_GRAPH_CONCURRENT_LIST_HPP
+
+#include "concurrent_list/concurrent_list_unweighted.hpp"
+#include "concurrent_list/concurrent_list_weighted.hpp"
+#include "concurrent_list/clist_vertex_iterator.hpp"
+#include "concurrent_list/clist_edge_iterator.hpp"
+#include "concurrent_list/clist_view.hpp"
+
+#endif
@@ -0,0 +1,161 @@
+#ifndef LION_GRAPH_CLIST_EDGE_ITERATOR_HPP
+#define LION_GRAPH_CLIST_EDGE_ITERATOR_HPP
+
+#include "concurrent_list_unweighted.hpp"
+#include "concurrent_list_weighted.hpp"
+
+#include <type_traits>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+
+namespace lion::graph
+{
+	// unweighted, walks the one row block begin() loaded, a default
+	// constructed iterator is the end of every row. targets at or past
+	// bound are skipped, a view passes the bound it was made with
+	template<typename Vertex, typename Weight, typename Allocator>
+	class concurrent_list<std::false_type, Vertex, Weight, Allocator>::edge_iterator
+	{
+	private:
+		template<typename Weighted, typename... Ts>
+		friend class concurrent_list;
+
+		using list = concurrent_list<std::false_type, Vertex, Weight, Allocator>;
+
+		const typename list::id_list* row = nullptr;
+		std::size_t current = 0;
+		const typename list::vertices_list* vertices = nullptr;
+		std::size_t bound = static_cast<std::size_t>(-1);
+
+		edge_iterator(decltype(row) r, const typename list::vertices_list& verts, std::size_t b = static_cast<std::size_t>(-1))
+			: row(r), vertices(std::addressof(verts)), bound(b)
+		{
+			skip();
+		}
+
+		void skip()
+		{
+			while (!at_end() && (*row)[current] >= bound) {
+				++current;
+			}
+		}
+
+		bool at_end() const noexcept { return !row || current == row->size(); }
+
+	public:
+		using value_type		= typename list::vertex_type;
+		using reference			= const value_type&;
+		using pointer			= const value_type*;
+		using difference_type	= std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+
+		edge_iterator() = default;
+		edge_iterator(const edge_iterator&) = default;
+		edge_iterator& operator=(const edge_iterator&) = default;
+
+		edge_iterator& operator++()
+		{
+			++current;
+			skip();
+			return *this;
+		}
+
+		edge_iterator operator++(int)
+		{
+			edge_iterator temp(*this);
+			++*this;
+			return temp;
+		}
+
+		reference operator*() const { return vertices->key_of((*row)[current]); }
+		pointer operator->()  const { return std::addressof(operator*()); }
+
+		friend bool operator==(const edge_iterator& lhs, const edge_iterator& rhs) {
+			return lhs.at_end() || rhs.at_end() ? lhs.at_end() == rhs.at_end() : lhs.current == rhs.current;
+		}
+		friend bool operator!=(const edge_iterator& lhs, const edge_iterator& rhs) {
+			return !(lhs == rhs);
+		}
+	};
+
+	// weighted
+	template<typename Vertex, typename Weight, typename Allocator>
+	class concurrent_list<std::true_type, Vertex, Weight, Allocator>::edge_iterator
+	{
+	private:
+		template<typename Weighted, typename... Ts>
+		friend class concurrent_list;
+
+		using list = concurrent_list<std::true_type, Vertex, Weight, Allocator>;
+
+		const typename list::row* block = nullptr;
+		std::size_t current = 0;
+		const typename list::vertices_list* vertices = nullptr;
+		std::size_t bound = static_cast<std::size_t>(-1);
+
+		edge_iterator(decltype(block) b, const typename list::vertices_list& verts, std::size_t bd = static_cast<std::size_t>(-1))
+			: block(b), vertices(std::addressof(verts)), bound(bd)
+		{
+			skip();
+		}
+
+		void skip()
+		{
+			while (!at_end() && block->targets[current] >= bound) {
+				++current;
+			}
+		}
+
+		bool at_end() const noexcept { return !block || current == block->targets.size(); }
+
+	public:
+		struct value_type
+		{
+			const typename list::vertex_type& second;
+			const typename list::weight_type& weight;
+
+			operator const typename list::vertex_type&() const { return second; }
+		};
+
+		struct pointer
+		{
+			value_type value;
+			const value_type* operator->() const { return std::addressof(value); }
+		};
+
+		using reference			= value_type;
+		using difference_type	= std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+
+		edge_iterator() = default;
+		edge_iterator(const edge_iterator&) = default;
+		edge_iterator& operator=(const edge_iterator&) = default;
+
+		edge_iterator& operator++()
+		{
+			++current;
+			skip();
+			return *this;
+		}
+
+		edge_iterator operator++(int)
+		{
+			edge_iterator temp(*this);
+			++*this;
+			return temp;
+		}
+
+		reference operator*() const { return { vertices->key_of(block->targets[current]), block->weights[current] }; }
+		pointer operator->()  const { return { operator*() }; }
+
+		friend bool operator==(const edge_iterator& lhs, const edge_iterator& rhs) {
+			return lhs.at_end() || rhs.at_end() ? lhs.at_end() == rhs.at_end() : lhs.current == rhs.current;
+		}
+		friend bool operator!=(const edge_iterator& lhs, const edge_iterator& rhs) {
+			return !(lhs == rhs);
+		}
+	};
+}
+
+#endif
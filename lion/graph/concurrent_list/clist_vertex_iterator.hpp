@@ -0,0 +1,146 @@
+#ifndef LION_GRAPH_CLIST_VERTEX_ITERATOR_HPP
+#define LION_GRAPH_CLIST_VERTEX_ITERATOR_HPP
+
+#include "concurrent_list_unweighted.hpp"
+#include "concurrent_list_weighted.hpp"
+
+#include <type_traits>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+
+namespace lion::graph
+{
+	// unweighted and weighted share one shape, the ids below the bound seen
+	// by begin() are visited and removed ones skipped. end() is a sentinel
+	template<typename Vertex, typename Weight, typename Allocator>
+	class concurrent_list<std::false_type, Vertex, Weight, Allocator>::vertex_iterator
+	{
+	private:
+		template<typename Weighted, typename... Ts>
+		friend class concurrent_list;
+
+		using list = concurrent_list<std::false_type, Vertex, Weight, Allocator>;
+
+		const typename list::vertices_list* vertices = nullptr;
+		std::size_t current = 0;
+		std::size_t bound = 0;
+
+		vertex_iterator(const typename list::vertices_list& verts, std::size_t id, std::size_t b)
+			: vertices(std::addressof(verts)), current(id), bound(b)
+		{
+			skip();
+		}
+
+		void skip()
+		{
+			while (current < bound && !vertices->alive(static_cast<typename list::id_type>(current))) {
+				++current;
+			}
+		}
+
+		bool at_end() const noexcept { return current >= bound; }
+
+	public:
+		using value_type		= typename list::vertex_type;
+		using reference			= const value_type&;
+		using pointer			= const value_type*;
+		using difference_type	= std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+
+		vertex_iterator() = default;
+		vertex_iterator(const vertex_iterator&) = default;
+		vertex_iterator& operator=(const vertex_iterator&) = default;
+
+		vertex_iterator& operator++()
+		{
+			++current;
+			skip();
+			return *this;
+		}
+
+		vertex_iterator operator++(int)
+		{
+			vertex_iterator temp(*this);
+			++*this;
+			return temp;
+		}
+
+		reference operator*() const { return vertices->key_of(static_cast<typename list::id_type>(current)); }
+		pointer operator->()  const { return std::addressof(operator*()); }
+
+		friend bool operator==(const vertex_iterator& lhs, const vertex_iterator& rhs) {
+			return lhs.at_end() || rhs.at_end() ? lhs.at_end() == rhs.at_end() : lhs.current == rhs.current;
+		}
+		friend bool operator!=(const vertex_iterator& lhs, const vertex_iterator& rhs) {
+			return !(lhs == rhs);
+		}
+	};
+
+	// weighted
+	template<typename Vertex, typename Weight, typename Allocator>
+	class concurrent_list<std::true_type, Vertex, Weight, Allocator>::vertex_iterator
+	{
+	private:
+		template<typename Weighted, typename... Ts>
+		friend class concurrent_list;
+
+		using list = concurrent_list<std::true_type, Vertex, Weight, Allocator>;
+
+		const typename list::vertices_list* vertices = nullptr;
+		std::size_t current = 0;
+		std::size_t bound = 0;
+
+		vertex_iterator(const typename list::vertices_list& verts, std::size_t id, std::size_t b)
+			: vertices(std::addressof(verts)), current(id), bound(b)
+		{
+			skip();
+		}
+
+		void skip()
+		{
+			while (current < bound && !vertices->alive(static_cast<typename list::id_type>(current))) {
+				++current;
+			}
+		}
+
+		bool at_end() const noexcept { return current >= bound; }
+
+	public:
+		using value_type		= typename list::vertex_type;
+		using reference			= const value_type&;
+		using pointer			= const value_type*;
+		using difference_type	= std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+
+		vertex_iterator() = default;
+		vertex_iterator(const vertex_iterator&) = default;
+		vertex_iterator& operator=(const vertex_iterator&) = default;
+
+		vertex_iterator& operator++()
+		{
+			++current;
+			skip();
+			return *this;
+		}
+
+		vertex_iterator operator++(int)
+		{
+			vertex_iterator temp(*this);
+			++*this;
+			return temp;
+		}
+
+		reference operator*() const { return vertices->key_of(static_cast<typename list::id_type>(current)); }
+		pointer operator->()  const { return std::addressof(operator*()); }
+
+		friend bool operator==(const vertex_iterator& lhs, const vertex_iterator& rhs) {
+			return lhs.at_end() || rhs.at_end() ? lhs.at_end() == rhs.at_end() : lhs.current == rhs.current;
+		}
+		friend bool operator!=(const vertex_iterator& lhs, const vertex_iterator& rhs) {
+			return !(lhs == rhs);
+		}
+	};
+}
+
+#endif
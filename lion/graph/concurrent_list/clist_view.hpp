@@ -0,0 +1,321 @@
+#ifndef LION_GRAPH_CLIST_VIEW_HPP
+#define LION_GRAPH_CLIST_VIEW_HPP
+
+#include "../../range.hpp"
+#include "../detail/epoch.hpp"
+#include "concurrent_list_unweighted.hpp"
+#include "concurrent_list_weighted.hpp"
+#include "clist_vertex_iterator.hpp"
+#include "clist_edge_iterator.hpp"
+
+#include <type_traits>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+
+namespace lion::graph
+{
+	namespace detail
+	{
+		// the entries of one row whose target is below bound. values runs
+		// parallel to the targets and is what the iterator yields, the
+		// targets themselves for the range of ids
+		template<typename Id, typename T>
+		class bounded_row_iterator
+		{
+		private:
+			const Id* target = nullptr;
+			const Id* last = nullptr;
+			const T* value = nullptr;
+			std::size_t bound = 0;
+
+			void skip() noexcept
+			{
+				while (target != last && *target >= bound)
+				{
+					++target;
+					++value;
+				}
+			}
+
+		public:
+			using value_type		= T;
+			using reference			= const T&;
+			using pointer			= const T*;
+			using difference_type	= std::ptrdiff_t;
+			using iterator_category = std::forward_iterator_tag;
+
+			bounded_row_iterator() = default;
+
+			bounded_row_iterator(const Id* first, const Id* end, const T* values, std::size_t b) noexcept
+				: target(first), last(end), value(values), bound(b)
+			{
+				skip();
+			}
+
+			bounded_row_iterator& operator++() noexcept
+			{
+				++target;
+				++value;
+				skip();
+				return *this;
+			}
+
+			bounded_row_iterator operator++(int) noexcept
+			{
+				bounded_row_iterator temp(*this);
+				++*this;
+				return temp;
+			}
+
+			reference operator*() const noexcept { return *value; }
+			pointer operator->()  const noexcept { return value; }
+
+			friend bool operator==(const bounded_row_iterator& lhs, const bounded_row_iterator& rhs) noexcept {
+				return lhs.target == rhs.target;
+			}
+			friend bool operator!=(const bounded_row_iterator& lhs, const bounded_row_iterator& rhs) noexcept {
+				return !(lhs == rhs);
+			}
+		};
+	}
+
+	// unweighted, the graph by dense ids for algorithms that size their arrays
+	// by id_bound(). a view pins the graph for as long as it lives and fixes
+	// the bound when it is made: later vertices are not visited and targets
+	// at or past the bound are left out of every row, so a writer adding
+	// vertices meanwhile cannot push an algorithm past its arrays. rows are
+	// read as they are when reached, freeze into a csr for a fixed state
+	template<typename Vertex, typename Weight, typename Allocator>
+	class concurrent_list<std::false_type, Vertex, Weight, Allocator>::view_type
+	{
+	private:
+		template<typename Weighted, typename... Ts>
+		friend class concurrent_list;
+
+		using list = concurrent_list<std::false_type, Vertex, Weight, Allocator>;
+		using id_type = typename list::id_type;
+		using target_iterator = detail::bounded_row_iterator<id_type, id_type>;
+
+		detail::epoch_guard guard;
+		const typename list::vertices_list* directory;
+		std::size_t bound;
+
+		// pinned before the bound is read, every row loaded later is covered
+		explicit view_type(list& source)
+			: guard(source.pin()), directory(std::addressof(source.vertices)), bound(source.vertices.bound())
+		{}
+
+		const typename list::id_list* row_of(id_type id) const noexcept {
+			return id < bound ? list::targets_of(directory->row(id)) : nullptr;
+		}
+
+	public:
+		using vertex_type	  = typename list::vertex_type;
+		using allocator_type  = typename list::allocator_type;
+		using size_type		  = typename list::size_type;
+		using difference_type = typename list::difference_type;
+		using vertex_iterator = typename list::vertex_iterator;
+		using edge_iterator	  = typename list::edge_iterator;
+
+		view_type(view_type&&) = default;
+		view_type& operator=(view_type&&) = default;
+
+		bool contains(const vertex_type& vertex) const
+		{
+			const auto id = id_of(vertex);
+			return id < bound && directory->alive(id);
+		}
+
+		// the live ids below the bound, counted when asked
+		size_type vertex_count() const noexcept
+		{
+			size_type count = 0;
+			for (std::size_t id = 0; id < bound; ++id) {
+				count += directory->alive(static_cast<id_type>(id));
+			}
+			return count;
+		}
+
+		size_type degree(const vertex_type& vertex) const
+		{
+			const auto targets = this->targets(id_of(vertex));
+			return static_cast<size_type>(std::distance(targets.begin(), targets.end()));
+		}
+
+		id_type id_of(const vertex_type& vertex) const
+		{
+			const auto id = directory->find(vertex);
+			return id < bound ? id : list::vertices_list::npos;
+		}
+
+		const vertex_type& key_of(id_type id) const { return directory->key_of(id); }
+		size_type id_bound() const noexcept { return bound; }
+
+		// one row read once, without the targets at or past id_bound()
+		range<target_iterator> targets(id_type id) const noexcept
+		{
+			const auto* targets = row_of(id);
+			if (!targets) {
+				return { target_iterator(), target_iterator() };
+			}
+			const auto* first = targets->data();
+			const auto* last = first + targets->size();
+			return { target_iterator(first, last, first, bound), target_iterator(last, last, last, bound) };
+		}
+
+		vertex_iterator begin() const noexcept { return vertex_iterator(*directory, 0, bound); }
+		vertex_iterator end()   const noexcept { return vertex_iterator(); }
+
+		edge_iterator begin(const vertex_type& vert) const noexcept {
+			return edge_iterator(row_of(id_of(vert)), *directory, bound);
+		}
+		edge_iterator end(const vertex_type&) const noexcept {
+			return edge_iterator();
+		}
+
+		range<vertex_iterator> vertices() const noexcept {
+			return { this->begin(), this->end() };
+		}
+
+		range<edge_iterator> edges(const vertex_type& vert) const noexcept {
+			return { this->begin(vert), this->end(vert) };
+		}
+
+		allocator_type get_allocator() const { return directory->get_allocator(); }
+	};
+
+	// weighted, row(id) hands out the targets and weights of one row block
+	// read once. targets(id) and weights() of another row(id) could come
+	// from different blocks if a writer replaced the row in between
+	template<typename Vertex, typename Weight, typename Allocator>
+	class concurrent_list<std::true_type, Vertex, Weight, Allocator>::view_type
+	{
+	private:
+		template<typename Weighted, typename... Ts>
+		friend class concurrent_list;
+
+		using list = concurrent_list<std::true_type, Vertex, Weight, Allocator>;
+		using id_type = typename list::id_type;
+		using target_iterator = detail::bounded_row_iterator<id_type, id_type>;
+		using weight_iterator = detail::bounded_row_iterator<id_type, typename list::weight_type>;
+
+		detail::epoch_guard guard;
+		const typename list::vertices_list* directory;
+		std::size_t bound;
+
+		// pinned before the bound is read, every row loaded later is covered
+		explicit view_type(list& source)
+			: guard(source.pin()), directory(std::addressof(source.vertices)), bound(source.vertices.bound())
+		{}
+
+		const typename list::row* block_of(id_type id) const noexcept {
+			return id < bound ? directory->row(id) : nullptr;
+		}
+
+	public:
+		using vertex_type	  = typename list::vertex_type;
+		using weight_type	  = typename list::weight_type;
+		using allocator_type  = typename list::allocator_type;
+		using size_type		  = typename list::size_type;
+		using difference_type = typename list::difference_type;
+		using vertex_iterator = typename list::vertex_iterator;
+		using edge_iterator	  = typename list::edge_iterator;
+
+		class row_type
+		{
+		private:
+			friend class view_type;
+
+			const typename list::row* block;
+			std::size_t bound;
+
+			row_type(const typename list::row* b, std::size_t bd) noexcept
+				: block(b), bound(bd)
+			{}
+
+		public:
+			range<target_iterator> targets() const noexcept
+			{
+				if (!block) {
+					return { target_iterator(), target_iterator() };
+				}
+				const auto* first = block->targets.data();
+				const auto* last = first + block->targets.size();
+				return { target_iterator(first, last, first, bound), target_iterator(last, last, last, bound) };
+			}
+
+			range<weight_iterator> weights() const noexcept
+			{
+				if (!block) {
+					return { weight_iterator(), weight_iterator() };
+				}
+				const auto* first = block->targets.data();
+				const auto* last = first + block->targets.size();
+				const auto* values = block->weights.data();
+				return { weight_iterator(first, last, values, bound), weight_iterator(last, last, values + block->weights.size(), bound) };
+			}
+		};
+
+		view_type(view_type&&) = default;
+		view_type& operator=(view_type&&) = default;
+
+		bool contains(const vertex_type& vertex) const
+		{
+			const auto id = id_of(vertex);
+			return id < bound && directory->alive(id);
+		}
+
+		// the live ids below the bound, counted when asked
+		size_type vertex_count() const noexcept
+		{
+			size_type count = 0;
+			for (std::size_t id = 0; id < bound; ++id) {
+				count += directory->alive(static_cast<id_type>(id));
+			}
+			return count;
+		}
+
+		size_type degree(const vertex_type& vertex) const
+		{
+			const auto targets = this->targets(id_of(vertex));
+			return static_cast<size_type>(std::distance(targets.begin(), targets.end()));
+		}
+
+		id_type id_of(const vertex_type& vertex) const
+		{
+			const auto id = directory->find(vertex);
+			return id < bound ? id : list::vertices_list::npos;
+		}
+
+		const vertex_type& key_of(id_type id) const { return directory->key_of(id); }
+		size_type id_bound() const noexcept { return bound; }
+
+		// one row read once, without the entries whose target is at or past id_bound()
+		row_type row(id_type id) const noexcept { return row_type(block_of(id), bound); }
+
+		range<target_iterator> targets(id_type id) const noexcept { return row(id).targets(); }
+
+		vertex_iterator begin() const noexcept { return vertex_iterator(*directory, 0, bound); }
+		vertex_iterator end()   const noexcept { return vertex_iterator(); }
+
+		edge_iterator begin(const vertex_type& vert) const noexcept {
+			return edge_iterator(block_of(id_of(vert)), *directory, bound);
+		}
+		edge_iterator end(const vertex_type&) const noexcept {
+			return edge_iterator();
+		}
+
+		range<vertex_iterator> vertices() const noexcept {
+			return { this->begin(), this->end() };
+		}
+
+		range<edge_iterator> edges(const vertex_type& vert) const noexcept {
+			return { this->begin(vert), this->end(vert) };
+		}
+
+		allocator_type get_allocator() const { return directory->get_allocator(); }
+	};
+}
+
+#endif
@@ -0,0 +1,298 @@
+#ifndef LION_GRAPH_CONCURRENT_LIST_UNWEIGHTED_HPP
+#define LION_GRAPH_CONCURRENT_LIST_UNWEIGHTED_HPP
+
+#include "../../range.hpp"
+#include "../detail/concurrent_directory.hpp"
+
+#include <type_traits>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <utility>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+namespace lion::graph
+{
+	template<typename Weighted, typename... Ts>
+	class concurrent_list;
+
+	// adjacency rows are immutable blocks behind atomic pointers, so any number
+	// of threads can read while writers take turns. a write copies the rows it
+	// touches, publishes the copies and frees the old blocks once no pinned
+	// reader can still see them. readers running beside writers hold a pin():
+	//
+	//   auto guard = graph.pin();
+	//   for (const auto& target : graph.edges(v)) { ... }
+	//
+	// every batch passed to add_edges or remove_edges rewrites each touched
+	// row once. removed vertices keep their id and come back under it.
+	// algorithms that work by id run on view(), which is pinned and never
+	// hands out an id past the bound it was made with
+	template<typename Vertex, typename Weight, typename Allocator>
+	class concurrent_list<std::false_type, Vertex, Weight, Allocator>
+	{
+	protected:
+		using vertex_type	 = Vertex;
+		using allocator_type = Allocator;
+
+		struct edge_type
+		{
+			vertex_type first;
+			vertex_type second;
+		};
+
+	private:
+		using id_type = vertex_id;
+
+		using id_list = std::vector<
+			id_type,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<id_type>
+		>;
+
+		struct row
+		{
+			id_list targets;
+
+			explicit row(const allocator_type& alloc)
+				: targets(alloc)
+			{}
+		};
+
+		using vertices_list = detail::concurrent_directory<vertex_type, row, allocator_type>;
+
+		using pending_list = std::vector<
+			std::pair<id_type, id_type>,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<std::pair<id_type, id_type>>
+		>;
+
+		vertices_list vertices;
+		std::mutex writer;
+		std::atomic<std::size_t> edges{ 0 };
+
+	protected:
+		using size_type		  = std::size_t;
+		using difference_type = std::ptrdiff_t;
+
+		class vertex_iterator;
+		class edge_iterator;
+
+		explicit concurrent_list(const allocator_type& alloc = allocator_type{})
+			: vertices(alloc)
+		{}
+
+	private:
+		template<typename V>
+		id_type intern(V&& vertex) {
+			return vertices.intern(std::forward<V>(vertex)).first;
+		}
+
+		static const id_list* targets_of(const row* block) noexcept {
+			return block ? &block->targets : nullptr;
+		}
+
+		// pending is grouped by source, every touched row is copied once with
+		// the additions appended or the removed targets left out
+		void rewrite(pending_list& pending, bool add)
+		{
+			// additions keep their order within a row, removals are searched
+			if (add)
+			{
+				std::stable_sort(pending.begin(), pending.end(), [](const auto& lhs, const auto& rhs) {
+					return lhs.first < rhs.first;
+				});
+			}
+			else {
+				std::sort(pending.begin(), pending.end());
+			}
+
+			for (auto run = pending.begin(); run != pending.end();)
+			{
+				const id_type x = run->first;
+				const auto run_end = std::find_if(run, pending.end(), [x](const auto& edge) { return edge.first != x; });
+
+				const row* old = vertices.row(x);
+				row* next = vertices.make_row(get_allocator());
+				if (old) {
+					next->targets.reserve(old->targets.size() + (add ? run_end - run : 0));
+				}
+
+				if (add)
+				{
+					if (old) {
+						next->targets.assign(old->targets.begin(), old->targets.end());
+					}
+					for (auto edge = run; edge != run_end; ++edge)
+					{
+						next->targets.push_back(edge->second);
+						vertices.add_in_degree(edge->second, 1);
+					}
+					edges.fetch_add(run_end - run, std::memory_order_relaxed);
+				}
+				else if (old)
+				{
+					for (const id_type target : old->targets)
+					{
+						const bool removed = std::binary_search(run, run_end, std::make_pair(x, target));
+						if (removed) {
+							vertices.add_in_degree(target, -1);
+						}
+						else {
+							next->targets.push_back(target);
+						}
+					}
+					edges.fetch_sub(old->targets.size() - next->targets.size(), std::memory_order_relaxed);
+				}
+
+				vertices.publish(x, next);
+				run = run_end;
+			}
+			vertices.collect();
+		}
+
+	public:
+		// readers beside a writer must hold one while they use anything
+		// they got from the graph, ranges and iterators included
+		detail::epoch_guard pin() noexcept { return vertices.pin(); }
+
+		class view_type;
+
+		// the graph by dense ids for algorithms that size arrays by id_bound(),
+		// see view_type. the view holds a pin of its own
+		view_type view() { return view_type(*this); }
+
+		void add_edge(const edge_type& edge) { add_edges(&edge, &edge + 1); }
+
+		template<typename ForwardIterator>
+		void add_edges(ForwardIterator first, ForwardIterator last)
+		{
+			std::lock_guard<std::mutex> lock(writer);
+
+			pending_list pending(get_allocator());
+			pending.reserve(std::distance(first, last));
+			for (; first != last; ++first)
+			{
+				const auto& edge = *first;
+				const auto x = intern(edge.first);
+				pending.push_back({ x, intern(edge.second) });
+			}
+			rewrite(pending, true);
+		}
+
+		void add_vertex(const vertex_type& vertex)
+		{
+			std::lock_guard<std::mutex> lock(writer);
+			intern(vertex);
+		}
+
+		void add_vertex(vertex_type&& vertex)
+		{
+			std::lock_guard<std::mutex> lock(writer);
+			intern(std::move(vertex));
+		}
+
+		// every edge from first to second is removed
+		void remove_edge(const edge_type& edge) { remove_edges(&edge, &edge + 1); }
+
+		template<typename ForwardIterator>
+		void remove_edges(ForwardIterator first, ForwardIterator last)
+		{
+			std::lock_guard<std::mutex> lock(writer);
+
+			pending_list pending(get_allocator());
+			for (; first != last; ++first)
+			{
+				const auto& edge = *first;
+				const auto x = vertices.find(edge.first);
+				const auto y = vertices.find(edge.second);
+				if (x != vertices_list::npos && y != vertices_list::npos) {
+					pending.push_back({ x, y });
+				}
+			}
+			rewrite(pending, false);
+		}
+
+		// every row is scanned for edges into the vertex, there are no in-lists
+		void remove_vertex(const vertex_type& vertex)
+		{
+			std::lock_guard<std::mutex> lock(writer);
+
+			const auto id = vertices.find(vertex);
+			if (id == vertices_list::npos || !vertices.alive(id)) {
+				return;
+			}
+
+			pending_list pending(get_allocator());
+			if (const row* self = vertices.row(id))
+			{
+				for (const id_type target : self->targets) {
+					pending.push_back({ id, target });
+				}
+			}
+			for (std::size_t x = 0; x < vertices.bound(); ++x)
+			{
+				const auto targets = targets_of(vertices.row(static_cast<id_type>(x)));
+				if (x != id && targets && std::find(targets->begin(), targets->end(), id) != targets->end()) {
+					pending.push_back({ static_cast<id_type>(x), id });
+				}
+			}
+			rewrite(pending, false);
+
+			vertices.publish(id, nullptr);
+			vertices.kill(id);
+			vertices.collect();
+		}
+
+		bool contains(const vertex_type& vertex) const
+		{
+			const auto id = vertices.find(vertex);
+			return id != vertices_list::npos && vertices.alive(id);
+		}
+
+		vertex_iterator get(const vertex_type& vertex) const
+		{
+			return contains(vertex) ? vertex_iterator(vertices, vertices.find(vertex), vertices.bound()) : end();
+		}
+
+		size_type adjacent(const vertex_type& x, const vertex_type& y) const
+		{
+			const auto targets = targets_of(vertices.row(vertices.find(x)));
+			return targets ? std::count(targets->begin(), targets->end(), vertices.find(y)) : 0;
+		}
+
+		size_type vertex_count() const noexcept { return vertices.size(); }
+		size_type edge_count()   const noexcept { return edges.load(std::memory_order_relaxed); }
+
+		size_type degree(const vertex_type& vertex) const
+		{
+			const auto targets = targets_of(vertices.row(vertices.find(vertex)));
+			return targets ? targets->size() : 0;
+		}
+
+		size_type in_degree(const vertex_type& vertex) const { return vertices.in_degree(vertices.find(vertex)); }
+
+		id_type id_of(const vertex_type& vertex) const { return vertices.find(vertex); }
+		const vertex_type& key_of(id_type id) const { return vertices.key_of(id); }
+
+		// blocks retired by writers and not yet freed
+		std::size_t retired() const noexcept { return vertices.retired(); }
+
+		vertex_iterator begin() const noexcept { return vertex_iterator(vertices, 0, vertices.bound()); }
+		vertex_iterator end()   const noexcept { return vertex_iterator(); }
+
+		// begin() takes the row, end() is a sentinel, so a row swapped in
+		// between the two calls cannot pair one block's begin with another's end
+		edge_iterator begin(const vertex_type& vert) const noexcept {
+			return edge_iterator(targets_of(vertices.row(vertices.find(vert))), vertices);
+		}
+		edge_iterator end(const vertex_type&) const noexcept {
+			return edge_iterator();
+		}
+
+		allocator_type get_allocator() const { return vertices.get_allocator(); }
+	};
+}
+
+#endif
@@ -0,0 +1,335 @@
+#ifndef LION_GRAPH_CONCURRENT_LIST_WEIGHTED_HPP
+#define LION_GRAPH_CONCURRENT_LIST_WEIGHTED_HPP
+
+#include "../../range.hpp"
+#include "../detail/concurrent_directory.hpp"
+
+#include <type_traits>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <utility>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+namespace lion::graph
+{
+	template<typename Weighted, typename... Ts>
+	class concurrent_list;
+
+	// weights are stored in each row block next to the targets, so a pinned
+	// reader always sees the weights that belong to the targets it walks
+	template<typename Vertex, typename Weight, typename Allocator>
+	class concurrent_list<std::true_type, Vertex, Weight, Allocator>
+	{
+	protected:
+		using vertex_type	 = Vertex;
+		using weight_type	 = Weight;
+		using allocator_type = Allocator;
+
+		struct edge_type
+		{
+			vertex_type first;
+			vertex_type second;
+			weight_type weight;
+		};
+
+	private:
+		using id_type = vertex_id;
+
+		using id_list = std::vector<
+			id_type,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<id_type>
+		>;
+
+		using weight_list = std::vector<
+			weight_type,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<weight_type>
+		>;
+
+		struct row
+		{
+			id_list targets;
+			weight_list weights;
+
+			explicit row(const allocator_type& alloc)
+				: targets(alloc), weights(alloc)
+			{}
+		};
+
+		struct pending_edge
+		{
+			id_type x;
+			id_type y;
+			weight_type weight;
+		};
+
+		using vertices_list = detail::concurrent_directory<vertex_type, row, allocator_type>;
+
+		using pending_list = std::vector<
+			pending_edge,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<pending_edge>
+		>;
+
+		vertices_list vertices;
+		std::mutex writer;
+		std::atomic<std::size_t> edges{ 0 };
+
+	protected:
+		using size_type		  = std::size_t;
+		using difference_type = std::ptrdiff_t;
+
+		class vertex_iterator;
+		class edge_iterator;
+
+		explicit concurrent_list(const allocator_type& alloc = allocator_type{})
+			: vertices(alloc)
+		{}
+
+	private:
+		template<typename V>
+		id_type intern(V&& vertex) {
+			return vertices.intern(std::forward<V>(vertex)).first;
+		}
+
+		static const id_list* targets_of(const row* block) noexcept {
+			return block ? &block->targets : nullptr;
+		}
+
+		// pending is grouped by source, every touched row is copied once with
+		// the additions appended or the removed targets left out
+		void rewrite(pending_list& pending, bool add)
+		{
+			// additions keep their order within a row, removals are searched
+			if (add)
+			{
+				std::stable_sort(pending.begin(), pending.end(), [](const auto& lhs, const auto& rhs) {
+					return lhs.x < rhs.x;
+				});
+			}
+			else
+			{
+				std::sort(pending.begin(), pending.end(), [](const auto& lhs, const auto& rhs) {
+					return lhs.x != rhs.x ? lhs.x < rhs.x : lhs.y < rhs.y;
+				});
+			}
+
+			for (auto run = pending.begin(); run != pending.end();)
+			{
+				const id_type x = run->x;
+				const auto run_end = std::find_if(run, pending.end(), [x](const auto& edge) { return edge.x != x; });
+
+				const row* old = vertices.row(x);
+				row* next = vertices.make_row(get_allocator());
+				if (old)
+				{
+					next->targets.reserve(old->targets.size() + (add ? run_end - run : 0));
+					next->weights.reserve(old->targets.size() + (add ? run_end - run : 0));
+				}
+
+				if (add)
+				{
+					if (old)
+					{
+						next->targets.assign(old->targets.begin(), old->targets.end());
+						next->weights.assign(old->weights.begin(), old->weights.end());
+					}
+					for (auto edge = run; edge != run_end; ++edge)
+					{
+						next->targets.push_back(edge->y);
+						next->weights.push_back(std::move(edge->weight));
+						vertices.add_in_degree(edge->y, 1);
+					}
+					edges.fetch_add(run_end - run, std::memory_order_relaxed);
+				}
+				else if (old)
+				{
+					for (std::size_t i = 0; i < old->targets.size(); ++i)
+					{
+						const id_type target = old->targets[i];
+						const auto find = std::lower_bound(run, run_end, target, [](const pending_edge& edge, id_type id) {
+							return edge.y < id;
+						});
+						const bool removed = find != run_end && find->y == target;
+						if (removed) {
+							vertices.add_in_degree(target, -1);
+						}
+						else
+						{
+							next->targets.push_back(target);
+							next->weights.push_back(old->weights[i]);
+						}
+					}
+					edges.fetch_sub(old->targets.size() - next->targets.size(), std::memory_order_relaxed);
+				}
+
+				vertices.publish(x, next);
+				run = run_end;
+			}
+			vertices.collect();
+		}
+
+	public:
+		// readers beside a writer must hold one while they use anything
+		// they got from the graph, ranges and iterators included
+		detail::epoch_guard pin() noexcept { return vertices.pin(); }
+
+		class view_type;
+
+		// the graph by dense ids for algorithms that size arrays by id_bound(),
+		// see view_type. the view holds a pin of its own
+		view_type view() { return view_type(*this); }
+
+		void add_edge(const edge_type& edge) { add_edges(&edge, &edge + 1); }
+
+		template<typename ForwardIterator>
+		void add_edges(ForwardIterator first, ForwardIterator last)
+		{
+			std::lock_guard<std::mutex> lock(writer);
+
+			pending_list pending(get_allocator());
+			pending.reserve(std::distance(first, last));
+			for (; first != last; ++first)
+			{
+				const auto& edge = *first;
+				const auto x = intern(edge.first);
+				pending.push_back({ x, intern(edge.second), edge.weight });
+			}
+			rewrite(pending, true);
+		}
+
+		void add_vertex(const vertex_type& vertex)
+		{
+			std::lock_guard<std::mutex> lock(writer);
+			intern(vertex);
+		}
+
+		void add_vertex(vertex_type&& vertex)
+		{
+			std::lock_guard<std::mutex> lock(writer);
+			intern(std::move(vertex));
+		}
+
+		// every edge from first to second is removed, whatever its weight
+		void remove_edge(const edge_type& edge) { remove_edges(&edge, &edge + 1); }
+
+		template<typename ForwardIterator>
+		void remove_edges(ForwardIterator first, ForwardIterator last)
+		{
+			std::lock_guard<std::mutex> lock(writer);
+
+			pending_list pending(get_allocator());
+			for (; first != last; ++first)
+			{
+				const auto& edge = *first;
+				const auto x = vertices.find(edge.first);
+				const auto y = vertices.find(edge.second);
+				if (x != vertices_list::npos && y != vertices_list::npos) {
+					pending.push_back({ x, y, weight_type{} });
+				}
+			}
+			rewrite(pending, false);
+		}
+
+		// every row is scanned for edges into the vertex, there are no in-lists
+		void remove_vertex(const vertex_type& vertex)
+		{
+			std::lock_guard<std::mutex> lock(writer);
+
+			const auto id = vertices.find(vertex);
+			if (id == vertices_list::npos || !vertices.alive(id)) {
+				return;
+			}
+
+			pending_list pending(get_allocator());
+			if (const row* self = vertices.row(id))
+			{
+				for (const id_type target : self->targets) {
+					pending.push_back({ id, target, weight_type{} });
+				}
+			}
+			for (std::size_t x = 0; x < vertices.bound(); ++x)
+			{
+				const auto targets = targets_of(vertices.row(static_cast<id_type>(x)));
+				if (x != id && targets && std::find(targets->begin(), targets->end(), id) != targets->end()) {
+					pending.push_back({ static_cast<id_type>(x), id, weight_type{} });
+				}
+			}
+			rewrite(pending, false);
+
+			vertices.publish(id, nullptr);
+			vertices.kill(id);
+			vertices.collect();
+		}
+
+		bool contains(const vertex_type& vertex) const
+		{
+			const auto id = vertices.find(vertex);
+			return id != vertices_list::npos && vertices.alive(id);
+		}
+
+		vertex_iterator get(const vertex_type& vertex) const
+		{
+			return contains(vertex) ? vertex_iterator(vertices, vertices.find(vertex), vertices.bound()) : end();
+		}
+
+		// weight, if given, receives the weight of the last matching edge
+		size_type adjacent(const vertex_type& x, const vertex_type& y, weight_type* weight) const
+		{
+			const row* block = vertices.row(vertices.find(x));
+			if (!block) {
+				return 0;
+			}
+
+			const auto idxy = vertices.find(y);
+
+			size_type result = 0;
+			for (std::size_t i = 0; i < block->targets.size(); ++i)
+			{
+				if (block->targets[i] == idxy)
+				{
+					++result;
+					if (weight) {
+						*weight = block->weights[i];
+					}
+				}
+			}
+			return result;
+		}
+
+		size_type vertex_count() const noexcept { return vertices.size(); }
+		size_type edge_count()   const noexcept { return edges.load(std::memory_order_relaxed); }
+
+		size_type degree(const vertex_type& vertex) const
+		{
+			const auto targets = targets_of(vertices.row(vertices.find(vertex)));
+			return targets ? targets->size() : 0;
+		}
+
+		size_type in_degree(const vertex_type& vertex) const { return vertices.in_degree(vertices.find(vertex)); }
+
+		id_type id_of(const vertex_type& vertex) const { return vertices.find(vertex); }
+		const vertex_type& key_of(id_type id) const { return vertices.key_of(id); }
+
+		// blocks retired by writers and not yet freed
+		std::size_t retired() const noexcept { return vertices.retired(); }
+
+		vertex_iterator begin() const noexcept { return vertex_iterator(vertices, 0, vertices.bound()); }
+		vertex_iterator end()   const noexcept { return vertex_iterator(); }
+
+		// begin() takes the row, end() is a sentinel, so a row swapped in
+		// between the two calls cannot pair one block's begin with another's end
+		edge_iterator begin(const vertex_type& vert) const noexcept {
+			return edge_iterator(vertices.row(vertices.find(vert)), vertices);
+		}
+		edge_iterator end(const vertex_type&) const noexcept {
+			return edge_iterator();
+		}
+
+		allocator_type get_allocator() const { return vertices.get_allocator(); }
+	};
+}
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef LION_GRAPH_CSR_HPP
+#define LION_GRAPH_CSR_HPP
+
+#include "csr/csr_unweighted.hpp"
+#include "csr/csr_weighted.hpp"
+#include "csr/csr_vertex_iterator.hpp"
+#include "csr/csr_edge_iterator.hpp"
+
+#endif
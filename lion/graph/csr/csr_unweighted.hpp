@@ -0,0 +1,324 @@
+#ifndef LION_GRAPH_CSR_UNWEIGHTED_HPP
+#define LION_GRAPH_CSR_UNWEIGHTED_HPP
+
+#include "../../range.hpp"
+#include "../vertex_interner.hpp"
+
+#include <type_traits>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <iterator>
+#include <numeric>
+#include <algorithm>
+
+namespace lion::graph
+{
+	template<typename Weighted, typename... Ts>
+	class csr;
+
+	// immutable compressed sparse row storage, vertices are numbered densely
+	// in insertion order and the edges of vertex i are columns[offsets[i]..offsets[i + 1]]
+	template<typename Vertex, typename Weight, typename Allocator>
+	class csr<std::false_type, Vertex, Weight, Allocator>
+	{
+	protected:
+		using vertex_type	 = Vertex;
+		using allocator_type = Allocator;
+
+		struct edge_type
+		{
+			vertex_type first;
+			vertex_type second;
+		};
+
+	private:
+		using id_type = vertex_id;
+
+		using vertices_list = vertex_interner<vertex_type, id_type, allocator_type>;
+
+		using offset_list = std::vector<
+			std::size_t,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<std::size_t>
+		>;
+
+		using column_list = std::vector<
+			id_type,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<id_type>
+		>;
+
+		vertices_list vertices;
+		offset_list offsets;
+		column_list columns;
+		offset_list in_degrees;
+		bool sorted = false;
+
+	protected:
+		using size_type		  = typename vertices_list::size_type;
+		using difference_type = std::ptrdiff_t;
+
+		class vertex_iterator;
+		class edge_iterator;
+
+		explicit csr(const allocator_type& alloc = allocator_type{})
+			: vertices(alloc), offsets(1, 0, alloc), columns(alloc), in_degrees(alloc)
+		{}
+
+	private:
+		id_type intern(const vertex_type& vertex)
+		{
+			auto&&[id, succ] = vertices.insert(vertex);
+			if (succ)
+			{
+				offsets.push_back(offsets.back());
+				in_degrees.push_back(0);
+			}
+			return id;
+		}
+
+		template<typename Pending>
+		void rebuild(const Pending& pending)
+		{
+			offset_list next(vertices.bound() + 1, 0, get_allocator());
+			for (std::size_t v = 0; v + 1 < offsets.size(); ++v) {
+				next[v + 1] = offsets[v + 1] - offsets[v];
+			}
+			for (auto&&[x, y] : pending)
+			{
+				++next[x + 1];
+				++in_degrees[y];
+			}
+			std::partial_sum(next.begin(), next.end(), next.begin());
+
+			column_list merged(next.back(), get_allocator());
+			offset_list fill(next.begin(), std::prev(next.end()), get_allocator());
+
+			for (std::size_t v = 0; v + 1 < offsets.size(); ++v)
+			{
+				std::copy(columns.begin() + offsets[v], columns.begin() + offsets[v + 1], merged.begin() + fill[v]);
+				fill[v] += offsets[v + 1] - offsets[v];
+			}
+			for (auto&&[x, y] : pending) {
+				merged[fill[x]++] = y;
+			}
+
+			const auto rows = offsets.size() - 1;
+
+			offsets.swap(next);
+			columns.swap(merged);
+
+			if (sorted) {
+				sort_rows(rows, next);
+			}
+		}
+
+		// rows [0, rows) whose length still matches old are left alone
+		void sort_rows(std::size_t rows, const offset_list& old)
+		{
+			for (std::size_t v = 0; v + 1 < offsets.size(); ++v)
+			{
+				const auto first = offsets[v];
+				const auto last = offsets[v + 1];
+				if (v >= rows || last - first != old[v + 1] - old[v]) {
+					std::sort(columns.begin() + first, columns.begin() + last);
+				}
+			}
+		}
+
+	public:
+		template<typename ForwardIterator>
+		void add_edges(ForwardIterator first, ForwardIterator last)
+		{
+			std::vector<
+				std::pair<id_type, id_type>,
+				typename std::allocator_traits<allocator_type>::template rebind_alloc<std::pair<id_type, id_type>>
+			> pending(get_allocator());
+
+			pending.reserve(std::distance(first, last));
+			for (; first != last; ++first)
+			{
+				const auto& edge = *first;
+				const auto x = intern(edge.first);
+				const auto y = intern(edge.second);
+				pending.push_back({ x, y });
+			}
+			rebuild(pending);
+		}
+
+		void add_vertex(const vertex_type& vertex) { intern(vertex); }
+
+		template<typename Graph>
+		void assign(const Graph& graph)
+		{
+			vertices.clear();
+			offsets.assign(1, 0);
+			in_degrees.clear();
+			columns.clear();
+
+			for (const auto& vertex : graph.vertices()) {
+				intern(vertex);
+			}
+			for (std::size_t v = 0; v < vertices.bound(); ++v)
+			{
+				const auto edges = graph.edges(vertices.key_of(v));
+				offsets[v + 1] = offsets[v] + std::distance(edges.begin(), edges.end());
+			}
+
+			columns.reserve(offsets.back());
+			for (std::size_t v = 0; v < vertices.bound(); ++v)
+			{
+				for (const auto& edge : graph.edges(vertices.key_of(v)))
+				{
+					columns.push_back(vertices.id_of(edge));
+					++in_degrees[columns.back()];
+				}
+			}
+			if (sorted) {
+				sort_rows(0, offsets);
+			}
+		}
+
+		// renumbers the vertices so that order[i] becomes id i and rebuilds the
+		// rows in that order, vertices missing from order are dropped along
+		// with their edges. returns the old id to new id mapping
+		template<typename Order>
+		typename vertices_list::remap_type permute(const Order& order)
+		{
+			std::vector<
+				std::pair<id_type, id_type>,
+				typename std::allocator_traits<allocator_type>::template rebind_alloc<std::pair<id_type, id_type>>
+			> pending(get_allocator());
+			pending.reserve(columns.size());
+
+			const auto remap = vertices.permute(order);
+			for (std::size_t v = 0; v + 1 < offsets.size(); ++v)
+			{
+				for (auto i = offsets[v]; i != offsets[v + 1]; ++i)
+				{
+					if (remap[v] != vertices_list::npos && remap[columns[i]] != vertices_list::npos) {
+						pending.push_back({ remap[v], remap[columns[i]] });
+					}
+				}
+			}
+
+			offsets.assign(vertices.bound() + 1, 0);
+			columns.clear();
+			in_degrees.assign(vertices.bound(), 0);
+			rebuild(pending);
+
+			return remap;
+		}
+
+		bool contains(const vertex_type& vertex) const {
+			return vertices.contains(vertex);
+		}
+
+		vertex_iterator get(const vertex_type& vertex) const {
+			return vertex_iterator(vertices.find(vertex));
+		}
+
+		// orders every row by target id and keeps later batches ordered too,
+		// adjacent() then binary searches and rows can be merged directly
+		void sort_rows()
+		{
+			if (!sorted)
+			{
+				sorted = true;
+				sort_rows(0, offsets);
+			}
+		}
+
+		bool rows_sorted() const noexcept { return sorted; }
+
+		size_type adjacent(const vertex_type& x, const vertex_type& y) const
+		{
+			const auto idxx = vertices.id_of(x);
+			const auto idxy = vertices.id_of(y);
+
+			if (sorted)
+			{
+				const auto row = columns.begin() + offsets[idxx];
+				const auto[lo, hi] = std::equal_range(row, row + (offsets[idxx + 1] - offsets[idxx]), idxy);
+				return static_cast<size_type>(hi - lo);
+			}
+			return std::count(columns.begin() + offsets[idxx], columns.begin() + offsets[idxx + 1], idxy);
+		}
+
+		size_type vertex_count() const noexcept { return vertices.size(); }
+		size_type edge_count()   const noexcept { return columns.size(); }
+
+		size_type degree(const vertex_type& vertex) const
+		{
+			const auto index = vertices.id_of(vertex);
+			return offsets[index + 1] - offsets[index];
+		}
+
+		size_type in_degree(const vertex_type& vertex) const { return in_degrees[vertices.id_of(vertex)]; }
+
+		id_type id_of(const vertex_type& vertex) const { return vertices.id_of(vertex); }
+		const vertex_type& key_of(id_type id) const { return vertices.key_of(id); }
+		size_type id_bound() const noexcept { return vertices.bound(); }
+
+		range<const id_type*> targets(id_type id) const noexcept {
+			return { columns.data() + offsets[id], columns.data() + offsets[id + 1] };
+		}
+
+		// every edge has an id in [0, edge_bound()), the edges of a row are
+		// numbered consecutively from first_edge(id) in targets(id) order.
+		// ids are renumbered by add_edges and assign
+		std::size_t first_edge(id_type id) const noexcept { return offsets[id]; }
+		std::size_t edge_bound() const noexcept { return columns.size(); }
+		id_type target(std::size_t edge) const noexcept { return columns[edge]; }
+
+		// id of the first edge from x to y, npos_edge if there is none
+		std::size_t edge_id(const vertex_type& x, const vertex_type& y) const
+		{
+			const auto idxx = vertices.id_of(x);
+			const auto idxy = vertices.id_of(y);
+
+			const auto first = columns.begin() + offsets[idxx];
+			const auto last = columns.begin() + offsets[idxx + 1];
+			const auto find = sorted ? std::lower_bound(first, last, idxy) : std::find(first, last, idxy);
+			return find != last && *find == idxy ? static_cast<std::size_t>(find - columns.begin()) : npos_edge;
+		}
+
+		vertex_iterator begin() const noexcept { return vertex_iterator(vertices.begin()); }
+		vertex_iterator end()   const noexcept { return vertex_iterator(vertices.end()); }
+
+		edge_iterator begin(const vertex_type& vert) const noexcept
+		{
+			const auto index = vertices.id_of(vert);
+			return edge_iterator(columns.data() + offsets[index], vertices);
+		}
+
+		edge_iterator end(const vertex_type& vert) const noexcept
+		{
+			const auto index = vertices.id_of(vert);
+			return edge_iterator(columns.data() + offsets[index + 1], vertices);
+		}
+
+		friend bool operator==(const csr& lhs, const csr& rhs) {
+			return lhs.vertices == rhs.vertices && lhs.offsets == rhs.offsets && lhs.columns == rhs.columns;
+		}
+		friend bool operator!=(const csr& lhs, const csr& rhs) {
+			return !(lhs == rhs);
+		}
+
+		void swap(csr& rhs) noexcept(
+			noexcept(std::swap(vertices, rhs.vertices)) &&
+			noexcept(std::swap(offsets, rhs.offsets)) &&
+			noexcept(std::swap(columns, rhs.columns)))
+		{
+			std::swap(vertices, rhs.vertices);
+			std::swap(offsets, rhs.offsets);
+			std::swap(columns, rhs.columns);
+			std::swap(in_degrees, rhs.in_degrees);
+			std::swap(sorted, rhs.sorted);
+		}
+
+		allocator_type get_allocator() const { return vertices.get_allocator(); }
+	};
+}
+
+#endif
@@ -0,0 +1,281 @@
+#ifndef LION_GRAPH_DETAIL_BITOPS_HPP
+#define LION_GRAPH_DETAIL_BITOPS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+#if __cplusplus > 201703L && __has_include(<bit>)
+#include <bit>
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace lion::graph::detail
+{
+	inline constexpr std::size_t word_bits = 64;
+
+	constexpr std::size_t words_for(std::size_t bits) noexcept {
+		return (bits + word_bits - 1) / word_bits;
+	}
+
+	inline int countr_zero(std::uint64_t word) noexcept
+	{
+#if __cplusplus > 201703L && __has_include(<bit>)
+		return std::countr_zero(word);
+#elif defined(_MSC_VER)
+		unsigned long index;
+		return _BitScanForward64(&index, word) ? static_cast<int>(index) : 64;
+#else
+		return word ? __builtin_ctzll(word) : 64;
+#endif
+	}
+
+	inline int countl_zero(std::uint64_t word) noexcept
+	{
+#if __cplusplus > 201703L && __has_include(<bit>)
+		return std::countl_zero(word);
+#elif defined(_MSC_VER)
+		unsigned long index;
+		return _BitScanReverse64(&index, word) ? 63 - static_cast<int>(index) : 64;
+#else
+		return word ? __builtin_clzll(word) : 64;
+#endif
+	}
+
+	inline int popcount(std::uint64_t word) noexcept
+	{
+#if __cplusplus > 201703L && __has_include(<bit>)
+		return std::popcount(word);
+#elif defined(_MSC_VER)
+		return static_cast<int>(__popcnt64(word));
+#else
+		return __builtin_popcountll(word);
+#endif
+	}
+
+	// walks the positions of the set bits in [words, words + count),
+	// whole zero words are skipped without looking at their bits
+	template<typename T>
+	class set_bit_iterator
+	{
+	private:
+		const std::uint64_t* words = nullptr;
+		std::size_t count = 0;
+		std::size_t index = 0;
+		std::uint64_t current = 0;
+
+		void skip_empty()
+		{
+			while (current == 0 && ++index < count) {
+				current = words[index];
+			}
+		}
+
+	public:
+		using value_type		= T;
+		using reference			= T;
+		using pointer			= const T*;
+		using difference_type	= std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+
+		set_bit_iterator() = default;
+
+		// end iterator
+		set_bit_iterator(const std::uint64_t* w, std::size_t n) noexcept
+			: words(w), count(n), index(n)
+		{}
+
+		set_bit_iterator(const std::uint64_t* w, std::size_t n, std::size_t first)
+			: words(w), count(n), index(first / word_bits)
+		{
+			if (index < count)
+			{
+				current = words[index] & (~std::uint64_t(0) << (first % word_bits));
+				skip_empty();
+			}
+			else {
+				index = count;
+			}
+		}
+
+		set_bit_iterator& operator++()
+		{
+			current &= current - 1;
+			skip_empty();
+			return *this;
+		}
+
+		set_bit_iterator operator++(int)
+		{
+			set_bit_iterator temp(*this);
+			++*this;
+			return temp;
+		}
+
+		reference operator*() const {
+			return static_cast<T>(index * word_bits + countr_zero(current));
+		}
+
+		friend bool operator==(const set_bit_iterator& lhs, const set_bit_iterator& rhs) {
+			return lhs.index == rhs.index && lhs.current == rhs.current;
+		}
+		friend bool operator!=(const set_bit_iterator& lhs, const set_bit_iterator& rhs) {
+			return !(lhs == rhs);
+		}
+	};
+
+	// the values stored at the positions of the set bits, in the same order
+	// set_bit_iterator visits them
+	template<typename T>
+	class set_bit_value_iterator
+	{
+	private:
+		set_bit_iterator<std::size_t> position;
+		T* values = nullptr;
+
+	public:
+		using value_type		= std::remove_const_t<T>;
+		using reference			= T&;
+		using pointer			= T*;
+		using difference_type	= std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+
+		set_bit_value_iterator() = default;
+
+		set_bit_value_iterator(set_bit_iterator<std::size_t> p, T* v) noexcept
+			: position(p), values(v)
+		{}
+
+		set_bit_value_iterator& operator++()
+		{
+			++position;
+			return *this;
+		}
+
+		set_bit_value_iterator operator++(int)
+		{
+			set_bit_value_iterator temp(*this);
+			++position;
+			return temp;
+		}
+
+		reference operator*() const { return values[*position]; }
+		pointer operator->()  const { return values + *position; }
+
+		friend bool operator==(const set_bit_value_iterator& lhs, const set_bit_value_iterator& rhs) {
+			return lhs.position == rhs.position;
+		}
+		friend bool operator!=(const set_bit_value_iterator& lhs, const set_bit_value_iterator& rhs) {
+			return !(lhs == rhs);
+		}
+	};
+
+	// the targets of a row that is kept either as a sorted list or as a
+	// bitmap. slot() is where the row keeps a value for the target, its
+	// index in the list or the target itself in a bitmap
+	template<typename T>
+	class row_iterator
+	{
+	private:
+		set_bit_iterator<T> bits;
+		const T* base = nullptr;
+		const T* current = nullptr;
+		bool list = false;
+
+	public:
+		using value_type		= T;
+		using reference			= T;
+		using pointer			= const T*;
+		using difference_type	= std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+
+		row_iterator() = default;
+
+		explicit row_iterator(set_bit_iterator<T> b) noexcept
+			: bits(b)
+		{}
+
+		// at curr in the list starting at b
+		row_iterator(const T* b, const T* curr) noexcept
+			: base(b), current(curr), list(true)
+		{}
+
+		row_iterator& operator++()
+		{
+			if (list) {
+				++current;
+			}
+			else {
+				++bits;
+			}
+			return *this;
+		}
+
+		row_iterator operator++(int)
+		{
+			row_iterator temp(*this);
+			++*this;
+			return temp;
+		}
+
+		reference operator*() const { return list ? *current : *bits; }
+
+		std::size_t slot() const { return list ? static_cast<std::size_t>(current - base) : static_cast<std::size_t>(*bits); }
+
+		friend bool operator==(const row_iterator& lhs, const row_iterator& rhs) {
+			return lhs.list ? lhs.current == rhs.current : lhs.bits == rhs.bits;
+		}
+		friend bool operator!=(const row_iterator& lhs, const row_iterator& rhs) {
+			return !(lhs == rhs);
+		}
+	};
+
+	// the values at the slots of a row_iterator
+	template<typename T, typename Id>
+	class row_value_iterator
+	{
+	private:
+		row_iterator<Id> position;
+		T* values = nullptr;
+
+	public:
+		using value_type		= std::remove_const_t<T>;
+		using reference			= T&;
+		using pointer			= T*;
+		using difference_type	= std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+
+		row_value_iterator() = default;
+
+		row_value_iterator(row_iterator<Id> p, T* v) noexcept
+			: position(p), values(v)
+		{}
+
+		row_value_iterator& operator++()
+		{
+			++position;
+			return *this;
+		}
+
+		row_value_iterator operator++(int)
+		{
+			row_value_iterator temp(*this);
+			++position;
+			return temp;
+		}
+
+		reference operator*() const { return values[position.slot()]; }
+		pointer operator->()  const { return values + position.slot(); }
+
+		friend bool operator==(const row_value_iterator& lhs, const row_value_iterator& rhs) {
+			return lhs.position == rhs.position;
+		}
+		friend bool operator!=(const row_value_iterator& lhs, const row_value_iterator& rhs) {
+			return !(lhs == rhs);
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,283 @@
+#ifndef LION_GRAPH_DETAIL_CONCURRENT_DIRECTORY_HPP
+#define LION_GRAPH_DETAIL_CONCURRENT_DIRECTORY_HPP
+
+#include "../vertex_interner.hpp"
+#include "bitops.hpp"
+#include "epoch.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace lion::graph::detail
+{
+	// vertex ids and adjacency rows readable without locks while one writer
+	// at a time changes them. ids live in segments that never move, segment k
+	// holds base << k slots, and keys are found through an open addressing
+	// table of ids that is replaced, never resized in place. a row is an
+	// immutable block, writers publish a new block and retire the old one
+	template<typename Key, typename Row, typename Allocator>
+	class concurrent_directory
+	{
+	public:
+		using key_type		 = Key;
+		using row_type		 = Row;
+		using id_type		 = vertex_id;
+		using allocator_type = Allocator;
+
+		static constexpr id_type npos = static_cast<id_type>(-1);
+
+	private:
+		static constexpr std::size_t base = 64;
+		static constexpr std::size_t max_segments = 48;
+
+		struct slot
+		{
+			std::atomic<const row_type*> row{ nullptr };
+			std::atomic<std::size_t> in_degree{ 0 };
+			std::atomic<bool> alive{ false };
+			alignas(key_type) unsigned char storage[sizeof(key_type)];
+
+			const key_type& key() const noexcept {
+				return *std::launder(reinterpret_cast<const key_type*>(storage));
+			}
+		};
+
+		struct table
+		{
+			std::size_t mask;
+			std::atomic<id_type>* cells;
+		};
+
+		using slot_allocator  = typename std::allocator_traits<allocator_type>::template rebind_alloc<slot>;
+		using cell_allocator  = typename std::allocator_traits<allocator_type>::template rebind_alloc<std::atomic<id_type>>;
+		using table_allocator = typename std::allocator_traits<allocator_type>::template rebind_alloc<table>;
+		using row_allocator	  = typename std::allocator_traits<allocator_type>::template rebind_alloc<row_type>;
+
+		allocator_type alloc;
+		epoch_domain domain;
+		std::atomic<slot*> segments[max_segments] = {};
+		std::atomic<table*> index{ nullptr };
+		std::atomic<std::size_t> ids{ 0 };
+		std::atomic<std::size_t> live{ 0 };
+
+		static std::size_t segment_of(std::size_t id, std::size_t& offset) noexcept
+		{
+			const std::size_t group = id / base + 1;
+			const std::size_t k = 63 - countl_zero(group);
+			offset = id - base * ((std::size_t(1) << k) - 1);
+			return k;
+		}
+
+		slot& at(std::size_t id) const noexcept
+		{
+			std::size_t offset;
+			const auto k = segment_of(id, offset);
+			return segments[k].load(std::memory_order_acquire)[offset];
+		}
+
+		table* make_table(std::size_t capacity)
+		{
+			table_allocator tables(alloc);
+			cell_allocator cells(alloc);
+
+			table* next = std::allocator_traits<table_allocator>::allocate(tables, 1);
+			next->mask = capacity - 1;
+			next->cells = std::allocator_traits<cell_allocator>::allocate(cells, capacity);
+			for (std::size_t i = 0; i < capacity; ++i) {
+				::new (static_cast<void*>(next->cells + i)) std::atomic<id_type>(npos);
+			}
+			return next;
+		}
+
+		static void destroy_table(void* self, void* block)
+		{
+			auto& directory = *static_cast<concurrent_directory*>(self);
+			auto* old = static_cast<table*>(block);
+
+			cell_allocator cells(directory.alloc);
+			std::allocator_traits<cell_allocator>::deallocate(cells, old->cells, old->mask + 1);
+			table_allocator tables(directory.alloc);
+			std::allocator_traits<table_allocator>::deallocate(tables, old, 1);
+		}
+
+		static void destroy_row(void* self, void* block)
+		{
+			row_allocator rows(static_cast<concurrent_directory*>(self)->alloc);
+			std::allocator_traits<row_allocator>::destroy(rows, static_cast<row_type*>(block));
+			std::allocator_traits<row_allocator>::deallocate(rows, static_cast<row_type*>(block), 1);
+		}
+
+		static void place(table& into, const key_type& key, id_type id) noexcept
+		{
+			for (std::size_t i = std::hash<key_type>{}(key) & into.mask;; i = (i + 1) & into.mask)
+			{
+				if (into.cells[i].load(std::memory_order_relaxed) == npos)
+				{
+					into.cells[i].store(id, std::memory_order_release);
+					return;
+				}
+			}
+		}
+
+	public:
+		explicit concurrent_directory(const allocator_type& al = allocator_type{})
+			: alloc(al)
+		{
+			index.store(make_table(base), std::memory_order_relaxed);
+		}
+
+		concurrent_directory(const concurrent_directory&) = delete;
+		concurrent_directory& operator=(const concurrent_directory&) = delete;
+
+		~concurrent_directory()
+		{
+			domain.drain();
+
+			slot_allocator slots(alloc);
+			const std::size_t bound = ids.load(std::memory_order_relaxed);
+			for (std::size_t id = 0; id < bound; ++id)
+			{
+				auto& current = at(id);
+				if (const auto* row = current.row.load(std::memory_order_relaxed)) {
+					destroy_row(this, const_cast<row_type*>(row));
+				}
+				std::allocator_traits<allocator_type>::destroy(alloc, std::launder(reinterpret_cast<key_type*>(current.storage)));
+			}
+			for (std::size_t k = 0; k < max_segments; ++k)
+			{
+				if (slot* segment = segments[k].load(std::memory_order_relaxed))
+				{
+					for (std::size_t i = 0; i < (base << k); ++i) {
+						std::allocator_traits<slot_allocator>::destroy(slots, segment + i);
+					}
+					std::allocator_traits<slot_allocator>::deallocate(slots, segment, base << k);
+				}
+			}
+			destroy_table(this, index.load(std::memory_order_relaxed));
+		}
+
+		epoch_guard pin() noexcept { return domain.pin(); }
+
+		// readers
+
+		id_type find(const key_type& key) const
+		{
+			const table* current = index.load();
+			for (std::size_t i = std::hash<key_type>{}(key) & current->mask;; i = (i + 1) & current->mask)
+			{
+				const id_type id = current->cells[i].load(std::memory_order_acquire);
+				if (id == npos || std::equal_to<key_type>{}(at(id).key(), key)) {
+					return id;
+				}
+			}
+		}
+
+		const key_type& key_of(id_type id) const noexcept { return at(id).key(); }
+
+		const row_type* row(id_type id) const noexcept { return at(id).row.load(); }
+
+		bool alive(id_type id) const noexcept { return at(id).alive.load(std::memory_order_acquire); }
+
+		std::size_t in_degree(id_type id) const noexcept { return at(id).in_degree.load(std::memory_order_relaxed); }
+
+		std::size_t bound() const noexcept { return ids.load(std::memory_order_acquire); }
+		std::size_t size() const noexcept { return live.load(std::memory_order_relaxed); }
+
+		// writer only from here on
+
+		// the id of key, a new id if it was never seen. the flag is true when
+		// the key was absent or removed, removed keys come back under their old id
+		template<typename K>
+		std::pair<id_type, bool> intern(K&& key)
+		{
+			const id_type found = find(key);
+			if (found != npos)
+			{
+				if (alive(found)) {
+					return { found, false };
+				}
+				at(found).alive.store(true, std::memory_order_release);
+				live.fetch_add(1, std::memory_order_relaxed);
+				return { found, true };
+			}
+
+			const std::size_t id = ids.load(std::memory_order_relaxed);
+
+			std::size_t offset;
+			const auto k = segment_of(id, offset);
+			if (offset == 0)
+			{
+				slot_allocator slots(alloc);
+				slot* segment = std::allocator_traits<slot_allocator>::allocate(slots, base << k);
+				for (std::size_t i = 0; i < (base << k); ++i) {
+					std::allocator_traits<slot_allocator>::construct(slots, segment + i);
+				}
+				segments[k].store(segment, std::memory_order_release);
+			}
+
+			auto& current = at(id);
+			std::allocator_traits<allocator_type>::construct(alloc,
+				reinterpret_cast<key_type*>(current.storage), std::forward<K>(key));
+			current.alive.store(true, std::memory_order_relaxed);
+
+			// at most half full, a grown table is filled before it is published
+			table* into = index.load(std::memory_order_relaxed);
+			if (2 * (id + 1) > into->mask + 1)
+			{
+				table* next = make_table(2 * (into->mask + 1));
+				for (std::size_t i = 0; i < id; ++i) {
+					place(*next, key_of(static_cast<id_type>(i)), static_cast<id_type>(i));
+				}
+				index.store(next);
+				domain.retire(into, &destroy_table, this);
+				into = next;
+			}
+			place(*into, current.key(), static_cast<id_type>(id));
+
+			ids.store(id + 1, std::memory_order_release);
+			live.fetch_add(1, std::memory_order_relaxed);
+			return { static_cast<id_type>(id), true };
+		}
+
+		void kill(id_type id)
+		{
+			at(id).alive.store(false, std::memory_order_release);
+			live.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		template<typename... Args>
+		row_type* make_row(Args&&... args)
+		{
+			row_allocator rows(alloc);
+			row_type* next = std::allocator_traits<row_allocator>::allocate(rows, 1);
+			std::allocator_traits<row_allocator>::construct(rows, next, std::forward<Args>(args)...);
+			return next;
+		}
+
+		// swaps in next, null for an empty row, and retires the old block
+		void publish(id_type id, const row_type* next)
+		{
+			const row_type* old = at(id).row.exchange(next);
+			if (old) {
+				domain.retire(const_cast<row_type*>(old), &destroy_row, this);
+			}
+		}
+
+		void add_in_degree(id_type id, std::ptrdiff_t delta) noexcept {
+			at(id).in_degree.fetch_add(static_cast<std::size_t>(delta), std::memory_order_relaxed);
+		}
+
+		// frees retired blocks that no pinned reader can reach any more
+		void collect() { domain.collect(); }
+
+		std::size_t retired() const noexcept { return domain.pending(); }
+
+		allocator_type get_allocator() const { return alloc; }
+	};
+}
+
+#endif
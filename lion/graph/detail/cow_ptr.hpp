@@ -0,0 +1,105 @@
+#ifndef LION_GRAPH_DETAIL_COW_PTR_HPP
+#define LION_GRAPH_DETAIL_COW_PTR_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace lion::graph::detail
+{
+	// shared block with an intrusive count, write() copies the block first
+	// unless this pointer is its only owner. copies may be dropped on other
+	// threads, the count is released and acquired so whoever writes next
+	// sees every read of the old owners finished
+	template<typename T, typename Allocator>
+	class cow_ptr
+	{
+	private:
+		struct node;
+
+		using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<node>;
+
+		struct node
+		{
+			std::atomic<std::size_t> refs{ 1 };
+			node_allocator alloc;
+			T value;
+
+			template<typename... Args>
+			explicit node(const node_allocator& al, Args&&... args)
+				: alloc(al), value(std::forward<Args>(args)...)
+			{}
+		};
+
+		node* current = nullptr;
+
+		explicit cow_ptr(node* n) noexcept
+			: current(n)
+		{}
+
+		void release() noexcept
+		{
+			if (current && current->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				node_allocator alloc(current->alloc);
+				std::allocator_traits<node_allocator>::destroy(alloc, current);
+				std::allocator_traits<node_allocator>::deallocate(alloc, current, 1);
+			}
+			current = nullptr;
+		}
+
+	public:
+		cow_ptr() = default;
+
+		cow_ptr(const cow_ptr& rhs) noexcept
+			: current(rhs.current)
+		{
+			if (current) {
+				current->refs.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		cow_ptr(cow_ptr&& rhs) noexcept
+			: current(std::exchange(rhs.current, nullptr))
+		{}
+
+		cow_ptr& operator=(cow_ptr rhs) noexcept
+		{
+			std::swap(current, rhs.current);
+			return *this;
+		}
+
+		~cow_ptr() { release(); }
+
+		// the block is built as T(args...), allocated through alloc
+		template<typename... Args>
+		static cow_ptr make(const Allocator& alloc, Args&&... args)
+		{
+			node_allocator nodes(alloc);
+			node* n = std::allocator_traits<node_allocator>::allocate(nodes, 1);
+			std::allocator_traits<node_allocator>::construct(nodes, n, nodes, std::forward<Args>(args)...);
+			return cow_ptr(n);
+		}
+
+		explicit operator bool() const noexcept { return current != nullptr; }
+
+		const T& operator*()  const noexcept { return current->value; }
+		const T* operator->() const noexcept { return std::addressof(current->value); }
+
+		bool unique() const noexcept {
+			return current && current->refs.load(std::memory_order_acquire) == 1;
+		}
+
+		// a block of our own, the shared one is copied as T(value, alloc)
+		T& write()
+		{
+			if (!unique()) {
+				*this = make(Allocator(current->alloc), current->value, Allocator(current->alloc));
+			}
+			return current->value;
+		}
+	};
+}
+
+#endif
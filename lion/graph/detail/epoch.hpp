@@ -0,0 +1,163 @@
+#ifndef LION_GRAPH_DETAIL_EPOCH_HPP
+#define LION_GRAPH_DETAIL_EPOCH_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace lion::graph::detail
+{
+	class epoch_domain;
+
+	// keeps whatever the pinning thread loads from the domain alive until the
+	// guard is released, pins are cheap and meant to cover one query
+	class epoch_guard
+	{
+	private:
+		friend class epoch_domain;
+
+		std::atomic<std::uint64_t>* slot = nullptr;
+
+		explicit epoch_guard(std::atomic<std::uint64_t>& s) noexcept
+			: slot(&s)
+		{}
+
+	public:
+		epoch_guard() = default;
+		epoch_guard(const epoch_guard&) = delete;
+		epoch_guard& operator=(const epoch_guard&) = delete;
+
+		epoch_guard(epoch_guard&& rhs) noexcept
+			: slot(std::exchange(rhs.slot, nullptr))
+		{}
+
+		epoch_guard& operator=(epoch_guard&& rhs) noexcept
+		{
+			if (this != &rhs)
+			{
+				release();
+				slot = std::exchange(rhs.slot, nullptr);
+			}
+			return *this;
+		}
+
+		~epoch_guard() { release(); }
+
+		void release() noexcept
+		{
+			if (slot) {
+				std::exchange(slot, nullptr)->store(0, std::memory_order_release);
+			}
+		}
+	};
+
+	// epoch based reclamation for one writer at a time and any number of
+	// readers. a writer unpublishes a block, retires it and later collects,
+	// a retired block is freed once every reader pinned before it was
+	// retired has let go. readers never write anything but their own slot.
+	// loads of published pointers have to be sequentially consistent too
+	class epoch_domain
+	{
+	public:
+		static constexpr std::size_t max_readers = 128;
+
+	private:
+		struct alignas(64) reader_slot
+		{
+			std::atomic<std::uint64_t> epoch{ 0 };
+		};
+
+		struct retired
+		{
+			void* block;
+			void (*destroy)(void* context, void* block);
+			void* context;
+			std::uint64_t epoch;
+		};
+
+		alignas(64) std::atomic<std::uint64_t> global{ 1 };
+		reader_slot readers[max_readers];
+		std::vector<retired> garbage;
+
+	public:
+		epoch_domain() = default;
+		epoch_domain(const epoch_domain&) = delete;
+		epoch_domain& operator=(const epoch_domain&) = delete;
+
+		~epoch_domain() { drain(); }
+
+		// claims a free reader slot, spinning only if max_readers pins are live
+		epoch_guard pin() noexcept
+		{
+			const auto start = std::hash<std::thread::id>{}(std::this_thread::get_id());
+			for (std::size_t i = start;; ++i)
+			{
+				auto& slot = readers[i % max_readers].epoch;
+				std::uint64_t idle = 0;
+				if (slot.load(std::memory_order_relaxed) == 0 &&
+					slot.compare_exchange_strong(idle, global.load(std::memory_order_acquire)))
+				{
+					return epoch_guard(slot);
+				}
+				if (i % max_readers == (start + max_readers - 1) % max_readers) {
+					std::this_thread::yield();
+				}
+			}
+		}
+
+		// writer only, block must already be unreachable for new readers
+		void retire(void* block, void (*destroy)(void*, void*), void* context)
+		{
+			garbage.push_back({ block, destroy, context, global.load(std::memory_order_relaxed) });
+		}
+
+		// writer only, frees every retired block no pinned reader can still see
+		void collect()
+		{
+			if (garbage.empty()) {
+				return;
+			}
+
+			// the claim in pin(), the unpublishing store, this increment and the
+			// scan are all sequentially consistent, so either the scan sees the
+			// reader's slot or the reader's loads see the blocks swapped out
+			std::uint64_t oldest = global.fetch_add(1) + 1;
+			for (const auto& reader : readers)
+			{
+				const auto epoch = reader.epoch.load();
+				if (epoch != 0 && epoch < oldest) {
+					oldest = epoch;
+				}
+			}
+
+			std::size_t kept = 0;
+			for (auto& item : garbage)
+			{
+				if (item.epoch < oldest) {
+					item.destroy(item.context, item.block);
+				}
+				else {
+					garbage[kept++] = item;
+				}
+			}
+			garbage.resize(kept);
+		}
+
+		// frees everything, only valid once no reader is pinned
+		void drain() noexcept
+		{
+			for (auto& item : garbage) {
+				item.destroy(item.context, item.block);
+			}
+			garbage.clear();
+		}
+
+		std::size_t pending() const noexcept { return garbage.size(); }
+	};
+}
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef LION_GRAPH_DETAIL_ID_INDEX_HPP
+#define LION_GRAPH_DETAIL_ID_INDEX_HPP
+
+#include "../vertex_interner.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace lion::graph::detail
+{
+	// keys to the ids 0, 1, 2, ... they were handed out as, for graphs whose
+	// copies share it. only ids are kept, keys are read back through key_of.
+	// one writer appends while any number of readers look up, every reader
+	// passes the bound of ids it knows of and ids at or past it count as
+	// absent. a full table is replaced, never resized in place, and the
+	// replaced ones are kept until the index goes: readers need no pinning
+	// and together they take less room than the table in use
+	template<typename Key, typename Allocator>
+	class id_index
+	{
+	public:
+		using key_type = Key;
+		using id_type  = vertex_id;
+
+		static constexpr id_type npos = static_cast<id_type>(-1);
+
+	private:
+		static constexpr std::size_t base = 64;
+
+		struct table
+		{
+			std::size_t mask;
+			std::atomic<id_type>* cells;
+			table* replaced;
+		};
+
+		using cell_allocator  = typename std::allocator_traits<Allocator>::template rebind_alloc<std::atomic<id_type>>;
+		using table_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<table>;
+
+		Allocator alloc;
+		std::atomic<table*> index{ nullptr };
+		std::atomic<std::size_t> claimed{ 0 };
+
+		table* make_table(std::size_t capacity, table* replaced)
+		{
+			table_allocator tables(alloc);
+			cell_allocator cells(alloc);
+
+			table* next = std::allocator_traits<table_allocator>::allocate(tables, 1);
+			next->mask = capacity - 1;
+			next->cells = std::allocator_traits<cell_allocator>::allocate(cells, capacity);
+			next->replaced = replaced;
+			for (std::size_t i = 0; i < capacity; ++i) {
+				::new (static_cast<void*>(next->cells + i)) std::atomic<id_type>(npos);
+			}
+			return next;
+		}
+
+		static void place(table& into, const key_type& key, id_type id) noexcept
+		{
+			for (std::size_t i = std::hash<key_type>{}(key) & into.mask;; i = (i + 1) & into.mask)
+			{
+				if (into.cells[i].load(std::memory_order_relaxed) == npos)
+				{
+					into.cells[i].store(id, std::memory_order_release);
+					return;
+				}
+			}
+		}
+
+	public:
+		explicit id_index(const Allocator& al)
+			: alloc(al)
+		{
+			index.store(make_table(base, nullptr), std::memory_order_relaxed);
+		}
+
+		// the ids below bound, for a copy that can no longer append to the
+		// index it shared: the keys are hashed again, once
+		template<typename KeyOf>
+		id_index(const Allocator& al, std::size_t bound, const KeyOf& key_of)
+			: alloc(al), claimed(bound)
+		{
+			std::size_t capacity = base;
+			while (capacity < 2 * (bound + 1)) {
+				capacity *= 2;
+			}
+			table* into = make_table(capacity, nullptr);
+			for (std::size_t i = 0; i < bound; ++i) {
+				place(*into, key_of(static_cast<id_type>(i)), static_cast<id_type>(i));
+			}
+			index.store(into, std::memory_order_relaxed);
+		}
+
+		id_index(const id_index&) = delete;
+		id_index& operator=(const id_index&) = delete;
+
+		~id_index()
+		{
+			table_allocator tables(alloc);
+			cell_allocator cells(alloc);
+			for (table* current = index.load(std::memory_order_relaxed); current;)
+			{
+				table* replaced = current->replaced;
+				std::allocator_traits<cell_allocator>::deallocate(cells, current->cells, current->mask + 1);
+				std::allocator_traits<table_allocator>::deallocate(tables, current, 1);
+				current = replaced;
+			}
+		}
+
+		template<typename KeyOf>
+		id_type find(const key_type& key, std::size_t bound, const KeyOf& key_of) const
+		{
+			const table* current = index.load();
+			for (std::size_t i = std::hash<key_type>{}(key) & current->mask;; i = (i + 1) & current->mask)
+			{
+				const id_type id = current->cells[i].load(std::memory_order_acquire);
+				if (id == npos) {
+					return npos;
+				}
+				if (id < bound && std::equal_to<key_type>{}(key_of(id), key)) {
+					return id;
+				}
+			}
+		}
+
+		// true if id is the next one and now belongs to the caller, false if
+		// another copy sharing the index took it first
+		bool claim(std::size_t id) noexcept {
+			return claimed.compare_exchange_strong(id, id + 1, std::memory_order_acq_rel);
+		}
+
+		// claimed ids only, key_of(id) has to be readable already. at most half
+		// full, a grown table is filled before it is published
+		template<typename KeyOf>
+		void append(id_type id, const KeyOf& key_of)
+		{
+			table* into = index.load(std::memory_order_relaxed);
+			if (2 * (static_cast<std::size_t>(id) + 1) > into->mask + 1)
+			{
+				table* next = make_table(2 * (into->mask + 1), into);
+				for (std::size_t i = 0; i < id; ++i) {
+					place(*next, key_of(static_cast<id_type>(i)), static_cast<id_type>(i));
+				}
+				index.store(next);
+				into = next;
+			}
+			place(*into, key_of(id), id);
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,569 @@
+#ifndef LION_GRAPH_DETAIL_PACKED_ARRAY_HPP
+#define LION_GRAPH_DETAIL_PACKED_ARRAY_HPP
+
+#include <type_traits>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <algorithm>
+
+namespace lion::graph::detail
+{
+	// walks the cells of [first, last) that are not gaps
+	template<typename Id>
+	class gap_iterator
+	{
+	private:
+		const Id* current = nullptr;
+		const Id* last = nullptr;
+
+		void skip() noexcept
+		{
+			while (current != last && *current == static_cast<Id>(-1)) {
+				++current;
+			}
+		}
+
+	public:
+		using value_type		= Id;
+		using reference			= const Id&;
+		using pointer			= const Id*;
+		using difference_type	= std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+
+		gap_iterator() = default;
+
+		gap_iterator(const Id* first, const Id* l) noexcept
+			: current(first), last(l)
+		{
+			skip();
+		}
+
+		gap_iterator& operator++() noexcept
+		{
+			++current;
+			skip();
+			return *this;
+		}
+
+		gap_iterator operator++(int) noexcept
+		{
+			gap_iterator temp(*this);
+			++*this;
+			return temp;
+		}
+
+		reference operator*() const noexcept { return *current; }
+		pointer operator->() const noexcept { return current; }
+
+		// position of the cell, the same index finds its value
+		const Id* cell() const noexcept { return current; }
+
+		friend bool operator==(const gap_iterator& lhs, const gap_iterator& rhs) {
+			return lhs.current == rhs.current;
+		}
+		friend bool operator!=(const gap_iterator& lhs, const gap_iterator& rhs) {
+			return !(lhs == rhs);
+		}
+	};
+
+	// the values that sit beside the non-gap cells of [first, last)
+	template<typename T, typename Id>
+	class gap_value_iterator
+	{
+	private:
+		gap_iterator<Id> current;
+		const Id* base = nullptr;
+		T* values = nullptr;
+
+	public:
+		using value_type		= std::remove_const_t<T>;
+		using reference			= T&;
+		using pointer			= T*;
+		using difference_type	= std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+
+		gap_value_iterator() = default;
+
+		gap_value_iterator(const Id* cells, T* vals, const Id* first, const Id* last) noexcept
+			: current(first, last), base(cells), values(vals)
+		{}
+
+		gap_value_iterator& operator++() noexcept
+		{
+			++current;
+			return *this;
+		}
+
+		gap_value_iterator operator++(int) noexcept
+		{
+			gap_value_iterator temp(*this);
+			++*this;
+			return temp;
+		}
+
+		reference operator*() const noexcept { return values[current.cell() - base]; }
+		pointer operator->() const noexcept { return values + (current.cell() - base); }
+
+		friend bool operator==(const gap_value_iterator& lhs, const gap_value_iterator& rhs) {
+			return lhs.current == rhs.current;
+		}
+		friend bool operator!=(const gap_value_iterator& lhs, const gap_value_iterator& rhs) {
+			return !(lhs == rhs);
+		}
+	};
+
+	// packed memory array of adjacency rows. every row starts with a sentinel
+	// cell holding its own id, followed by its targets, and rows follow each
+	// other in id order with gaps in between. an insert shifts cells inside
+	// one leaf or, when the leaf is full, spreads the smallest enclosing
+	// window that is still below its density bound, so inserts move
+	// O(log^2 n) cells amortized and rows stay nearly contiguous. Value is
+	// void when there are no weights, otherwise values[i] belongs to cells[i]
+	template<typename Id, typename Value, typename Allocator>
+	class packed_array
+	{
+	public:
+		using id_type = Id;
+
+		static constexpr id_type gap = static_cast<id_type>(-1);
+		static constexpr bool weighted = !std::is_void_v<Value>;
+
+	private:
+		using value_type = std::conditional_t<weighted, Value, char>;
+
+		static constexpr std::size_t min_capacity = 64;
+		static constexpr std::size_t min_leaf = 16;
+
+		using id_list = std::vector<
+			id_type,
+			typename std::allocator_traits<Allocator>::template rebind_alloc<id_type>
+		>;
+
+		using value_list = std::vector<
+			value_type,
+			typename std::allocator_traits<Allocator>::template rebind_alloc<value_type>
+		>;
+
+		using offset_list = std::vector<
+			std::size_t,
+			typename std::allocator_traits<Allocator>::template rebind_alloc<std::size_t>
+		>;
+
+		id_list cells;
+		value_list values;
+		offset_list starts;			// cell of the sentinel of every row
+		std::size_t used = 0;		// cells that are not gaps, sentinels included
+		std::size_t leaf = min_leaf;
+
+		id_list scratch_cells;
+		value_list scratch_values;
+		offset_list scratch_heads;	// scratch positions of sentinels, in id order
+
+		std::size_t capacity() const noexcept { return cells.size(); }
+
+		// the root may be 3/4 full, a leaf completely
+		bool fits(std::size_t count, std::size_t window) const noexcept
+		{
+			std::size_t height = 0;
+			while ((leaf << height) < capacity()) {
+				++height;
+			}
+			std::size_t level = 0;
+			while ((leaf << level) < window) {
+				++level;
+			}
+			return height == 0 ? 4 * count <= 3 * window : 4 * height * count <= (4 * height - level) * window;
+		}
+
+		// shifts the sentinels of rows starting in [first, last) by delta
+		void move_starts(std::size_t first, std::size_t last, std::ptrdiff_t delta)
+		{
+			auto v = std::lower_bound(starts.begin(), starts.end(), first);
+			for (; v != starts.end() && *v < last; ++v) {
+				*v += delta;
+			}
+		}
+
+		void put(std::size_t at, id_type cell, value_type* value)
+		{
+			cells[at] = cell;
+			if constexpr (weighted)
+			{
+				if (value) {
+					values[at] = std::move(*value);
+				}
+			}
+		}
+
+		void move_cell(std::size_t to, std::size_t from)
+		{
+			cells[to] = cells[from];
+			if constexpr (weighted) {
+				values[to] = std::move(values[from]);
+			}
+		}
+
+		// copies the window's cells in order into scratch, with an extra one
+		// right after cell after, whose sentinel row is head or npos
+		void gather(std::size_t first, std::size_t last, std::size_t after, id_type cell, value_type* value, std::size_t head)
+		{
+			scratch_cells.clear();
+			scratch_values.clear();
+			scratch_heads.clear();
+
+			auto v = std::lower_bound(starts.begin(), starts.end(), first);
+			const auto append = [&](id_type c, value_type* val) {
+				scratch_cells.push_back(c);
+				if constexpr (weighted) {
+					scratch_values.push_back(val ? std::move(*val) : value_type{});
+				}
+			};
+
+			if (after == std::size_t(-1) && head != std::size_t(-1))
+			{
+				scratch_heads.push_back(scratch_cells.size());
+				append(cell, value);
+			}
+			for (std::size_t i = first; i < last; ++i)
+			{
+				if (cells[i] != gap)
+				{
+					if (v != starts.end() && *v == i)
+					{
+						scratch_heads.push_back(scratch_cells.size());
+						++v;
+					}
+					append(cells[i], weighted ? &values[i] : nullptr);
+				}
+				if (i == after)
+				{
+					if (head != std::size_t(-1)) {
+						scratch_heads.push_back(scratch_cells.size());
+					}
+					append(cell, value);
+				}
+			}
+		}
+
+		// spreads scratch evenly over [first, first + window) and points the
+		// sentinels of rows first_row, first_row + 1, ... at their new cells
+		void scatter(std::size_t first, std::size_t window, std::size_t first_row)
+		{
+			std::fill(cells.begin() + first, cells.begin() + first + window, gap);
+
+			const std::size_t n = scratch_cells.size();
+			auto head = scratch_heads.begin();
+			for (std::size_t k = 0; k < n; ++k)
+			{
+				const std::size_t at = first + k * window / n;
+				cells[at] = scratch_cells[k];
+				if constexpr (weighted) {
+					values[at] = std::move(scratch_values[k]);
+				}
+				if (head != scratch_heads.end() && *head == k)
+				{
+					starts[first_row++] = at;
+					++head;
+				}
+			}
+		}
+
+		void resize(std::size_t next)
+		{
+			cells.assign(next, gap);
+			if constexpr (weighted) {
+				values.assign(next, value_type{});
+			}
+			leaf = min_leaf;
+			while ((std::size_t(1) << leaf) < next) {
+				leaf *= 2;
+			}
+		}
+
+		// every row respread over a new capacity, plus one extra cell
+		void respread(std::size_t next, std::size_t after, id_type cell, value_type* value, std::size_t head)
+		{
+			gather(0, capacity(), after, cell, value, head);
+			resize(next);
+			scatter(0, next, 0);
+		}
+
+		// the new cell goes right after cell after, or first when after is npos
+		void place(std::size_t after, id_type cell, value_type* value, std::size_t head)
+		{
+			if (capacity() == 0) {
+				resize(min_capacity);
+			}
+			if (after == std::size_t(-1))
+			{
+				// only sentinels are placed in front, and only into an empty array
+				put(0, cell, value);
+				starts[head] = 0;
+				++used;
+				return;
+			}
+
+			const std::size_t first = after / leaf * leaf;
+			const std::size_t last = first + leaf;
+
+			std::size_t g = after + 1;
+			while (g < last && cells[g] != gap) {
+				++g;
+			}
+			if (g < last)
+			{
+				for (std::size_t i = g; i > after + 1; --i) {
+					move_cell(i, i - 1);
+				}
+				move_starts(after + 1, g, 1);
+				put(after + 1, cell, value);
+				if (head != std::size_t(-1)) {
+					starts[head] = after + 1;
+				}
+				++used;
+				return;
+			}
+
+			g = after;
+			while (g > first && cells[g - 1] != gap) {
+				--g;
+			}
+			if (g > first)
+			{
+				--g;
+				for (std::size_t i = g; i < after; ++i) {
+					move_cell(i, i + 1);
+				}
+				move_starts(g + 1, after + 1, -1);
+				put(after, cell, value);
+				if (head != std::size_t(-1)) {
+					starts[head] = after;
+				}
+				++used;
+				return;
+			}
+
+			// the leaf is full, find the smallest window below its bound
+			for (std::size_t window = 2 * leaf; window <= capacity(); window *= 2)
+			{
+				const std::size_t begin = after / window * window;
+				const std::size_t count = 1 + static_cast<std::size_t>(
+					std::count_if(cells.begin() + begin, cells.begin() + begin + window, [](id_type c) { return c != gap; }));
+				if (fits(count, window))
+				{
+					const auto first_row = static_cast<std::size_t>(std::lower_bound(starts.begin(), starts.end(), begin) - starts.begin());
+					gather(begin, begin + window, after, cell, value, head);
+					scatter(begin, window, first_row);
+					++used;
+					return;
+				}
+			}
+			respread(2 * capacity(), after, cell, value, head);
+			++used;
+		}
+
+		// last cell in use of row id, its sentinel when the row is empty
+		std::size_t back(std::size_t id) const noexcept
+		{
+			std::size_t at = row_end(id) - 1;
+			while (cells[at] == gap) {
+				--at;
+			}
+			return at;
+		}
+
+		// shrinks once a quarter of the cells of half the capacity would be in use
+		void shrink()
+		{
+			if (capacity() > min_capacity && 8 * used < capacity()) {
+				respread(capacity() / 2, std::size_t(-1), gap, nullptr, std::size_t(-1));
+			}
+		}
+
+	public:
+		explicit packed_array(const Allocator& alloc = Allocator{})
+			: cells(alloc), values(alloc), starts(alloc), scratch_cells(alloc), scratch_values(alloc), scratch_heads(alloc)
+		{}
+
+		std::size_t rows() const noexcept { return starts.size(); }
+		std::size_t size() const noexcept { return used - starts.size(); }
+		std::size_t cell_count() const noexcept { return capacity(); }
+
+		// cells of row id are [row_begin(id), row_end(id)), gaps included
+		std::size_t row_begin(std::size_t id) const noexcept { return starts[id] + 1; }
+		std::size_t row_end(std::size_t id) const noexcept { return id + 1 < starts.size() ? starts[id + 1] : capacity(); }
+
+		const id_type* data() const noexcept { return cells.data(); }
+		const value_type* value_data() const noexcept { return values.data(); }
+
+		// a new empty row with the next id
+		void add_row()
+		{
+			const std::size_t id = starts.size();
+			const std::size_t after = used ? back(id - 1) : std::size_t(-1);
+			starts.push_back(capacity() + 1);
+			place(after, static_cast<id_type>(id), nullptr, id);
+		}
+
+		void insert(std::size_t id, id_type target)
+		{
+			place(back(id), target, nullptr, std::size_t(-1));
+		}
+
+		template<typename V>
+		void insert(std::size_t id, id_type target, V&& value)
+		{
+			value_type temp(std::forward<V>(value));
+			place(back(id), target, &temp, std::size_t(-1));
+		}
+
+		// appends to many rows at once: rows get their pending targets at the
+		// end in pending order, everything is respread in one pass. pending
+		// is ordered by row and holds first, second and, with values, weight
+		template<typename Pending>
+		void insert_sorted(Pending& pending)
+		{
+			const std::size_t total = used + pending.size();
+			std::size_t next = std::max(capacity(), min_capacity);
+			while (2 * total > next) {
+				next *= 2;
+			}
+
+			scratch_cells.clear();
+			scratch_values.clear();
+			scratch_heads.clear();
+
+			auto add = pending.begin();
+			for (std::size_t id = 0; id < starts.size(); ++id)
+			{
+				scratch_heads.push_back(scratch_cells.size());
+				scratch_cells.push_back(static_cast<id_type>(id));
+				if constexpr (weighted) {
+					scratch_values.push_back(value_type{});
+				}
+				for (std::size_t i = row_begin(id); i < row_end(id); ++i)
+				{
+					if (cells[i] != gap)
+					{
+						scratch_cells.push_back(cells[i]);
+						if constexpr (weighted) {
+							scratch_values.push_back(std::move(values[i]));
+						}
+					}
+				}
+				for (; add != pending.end() && add->first == id; ++add)
+				{
+					scratch_cells.push_back(add->second);
+					if constexpr (weighted) {
+						scratch_values.push_back(std::move(add->weight));
+					}
+				}
+			}
+
+			resize(next);
+			scatter(0, next, 0);
+			used = total;
+		}
+
+		// gaps every cell of row id holding target, returns how many
+		std::size_t erase(std::size_t id, id_type target)
+		{
+			std::size_t removed = 0;
+			for (std::size_t i = row_begin(id); i < row_end(id); ++i)
+			{
+				if (cells[i] == target)
+				{
+					cells[i] = gap;
+					++removed;
+				}
+			}
+			used -= removed;
+			if (removed) {
+				shrink();
+			}
+			return removed;
+		}
+
+		// gaps the whole row, calling f with every target first
+		template<typename Function>
+		void clear(std::size_t id, Function&& f)
+		{
+			std::size_t removed = 0;
+			for (std::size_t i = row_begin(id); i < row_end(id); ++i)
+			{
+				if (cells[i] != gap)
+				{
+					f(cells[i]);
+					cells[i] = gap;
+					++removed;
+				}
+			}
+			used -= removed;
+			if (removed) {
+				shrink();
+			}
+		}
+
+		// keeps only the rows remap sends somewhere and renumbers them and
+		// their targets through it, remap has to keep the rows in order.
+		// everything is respread over a capacity fitted to what is left
+		template<typename Remap>
+		void compact(const Remap& remap)
+		{
+			constexpr auto dropped = static_cast<id_type>(-1);
+
+			scratch_cells.clear();
+			scratch_values.clear();
+			scratch_heads.clear();
+
+			std::size_t kept = 0;
+			for (std::size_t id = 0; id < starts.size(); ++id)
+			{
+				if (remap[id] == dropped) {
+					continue;
+				}
+				++kept;
+				scratch_heads.push_back(scratch_cells.size());
+				scratch_cells.push_back(static_cast<id_type>(remap[id]));
+				if constexpr (weighted) {
+					scratch_values.push_back(value_type{});
+				}
+				for (std::size_t i = row_begin(id); i < row_end(id); ++i)
+				{
+					if (cells[i] != gap)
+					{
+						scratch_cells.push_back(static_cast<id_type>(remap[cells[i]]));
+						if constexpr (weighted) {
+							scratch_values.push_back(std::move(values[i]));
+						}
+					}
+				}
+			}
+
+			const std::size_t total = scratch_cells.size();
+			std::size_t next = min_capacity;
+			while (2 * total > next) {
+				next *= 2;
+			}
+
+			resize(next);
+			starts.resize(kept);
+			scatter(0, next, 0);
+			used = total;
+		}
+
+		void swap(packed_array& rhs) noexcept
+		{
+			std::swap(cells, rhs.cells);
+			std::swap(values, rhs.values);
+			std::swap(starts, rhs.starts);
+			std::swap(used, rhs.used);
+			std::swap(leaf, rhs.leaf);
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,196 @@
+#ifndef LION_GRAPH_DETAIL_PARALLEL_HPP
+#define LION_GRAPH_DETAIL_PARALLEL_HPP
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace lion::graph::detail
+{
+	// below grain items per thread spawning threads costs more than it saves
+	inline std::size_t thread_count(std::size_t work, std::size_t grain = std::size_t(1) << 15)
+	{
+		const std::size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+		return std::max<std::size_t>(1, std::min(hardware, work / grain));
+	}
+
+	// calls f(first, last, thread) for threads contiguous slices of [0, count),
+	// the calling thread takes the first slice
+	template<typename Function>
+	void parallel_for(std::size_t count, std::size_t threads, Function&& f)
+	{
+		if (threads <= 1)
+		{
+			f(std::size_t(0), count, std::size_t(0));
+			return;
+		}
+
+		const std::size_t chunk = (count + threads - 1) / threads;
+
+		std::vector<std::thread> pool;
+		pool.reserve(threads - 1);
+		for (std::size_t t = 1; t < threads; ++t)
+		{
+			pool.emplace_back([&f, t, chunk, count] {
+				f(std::min(t * chunk, count), std::min((t + 1) * chunk, count), t);
+			});
+		}
+		f(std::size_t(0), std::min(chunk, count), std::size_t(0));
+
+		for (auto& thread : pool) {
+			thread.join();
+		}
+	}
+
+	// count threads meet at wait(), none leaves before all have arrived.
+	// reusable, every round is told apart by its generation
+	class barrier
+	{
+	private:
+		std::mutex lock;
+		std::condition_variable arrived;
+		std::size_t count;
+		std::size_t waiting = 0;
+		std::size_t generation = 0;
+
+	public:
+		explicit barrier(std::size_t threads)
+			: count(threads)
+		{}
+
+		void wait()
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			const auto current = generation;
+			if (++waiting == count)
+			{
+				waiting = 0;
+				++generation;
+				arrived.notify_all();
+				return;
+			}
+			arrived.wait(guard, [&] { return generation != current; });
+		}
+	};
+
+	// a permutation of [0, count) in which items with equal keys are
+	// contiguous and keep their original relative order, group g is
+	// order[bounds[g]..bounds[g + 1]]
+	template<typename Allocator = std::allocator<std::size_t>>
+	struct key_groups
+	{
+		using index_list = std::vector<std::size_t, typename std::allocator_traits<Allocator>::template rebind_alloc<std::size_t>>;
+
+		index_list order;
+		index_list bounds;
+
+		explicit key_groups(const Allocator& alloc = Allocator{})
+			: order(alloc), bounds(alloc)
+		{}
+
+		std::size_t size() const noexcept { return bounds.size() - 1; }
+	};
+
+	// hashes in parallel, buckets by hash across threads and sorts every bucket
+	// on its own thread, so no step needs a shared hash table. every list it
+	// keeps comes from alloc
+	template<typename Key, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>, typename KeyOf,
+		typename Allocator = std::allocator<std::size_t>>
+	key_groups<Allocator> group_by_key(std::size_t count, std::size_t threads, KeyOf&& key_of, const Allocator& alloc = Allocator{})
+	{
+		using index_list = typename key_groups<Allocator>::index_list;
+
+		key_groups<Allocator> result(alloc);
+		result.order.resize(count);
+
+		index_list hashes(count, alloc);
+		parallel_for(count, threads, [&](std::size_t first, std::size_t last, std::size_t) {
+			for (auto i = first; i != last; ++i) {
+				hashes[i] = Hash{}(key_of(i));
+			}
+		});
+
+		// histogram[t * threads + b], items of thread t that fall into bucket b
+		index_list histogram(threads * threads, 0, alloc);
+		parallel_for(count, threads, [&](std::size_t first, std::size_t last, std::size_t t) {
+			for (auto i = first; i != last; ++i) {
+				++histogram[t * threads + hashes[i] % threads];
+			}
+		});
+
+		index_list offsets(threads * threads, 0, alloc);
+		index_list buckets(threads + 1, 0, alloc);
+		for (std::size_t b = 0, position = 0; b < threads; ++b)
+		{
+			for (std::size_t t = 0; t < threads; ++t)
+			{
+				offsets[t * threads + b] = position;
+				position += histogram[t * threads + b];
+			}
+			buckets[b + 1] = position;
+		}
+
+		parallel_for(count, threads, [&](std::size_t first, std::size_t last, std::size_t t) {
+			for (auto i = first; i != last; ++i) {
+				result.order[offsets[t * threads + hashes[i] % threads]++] = i;
+			}
+		});
+
+		// a bucket has at most as many groups as items, reserving here keeps the
+		// workers from allocating so alloc does not have to be thread safe
+		std::vector<index_list, typename std::allocator_traits<Allocator>::template rebind_alloc<index_list>> bucket_bounds(threads, index_list(alloc), alloc);
+		for (std::size_t b = 0; b < threads; ++b) {
+			bucket_bounds[b].reserve(buckets[b + 1] - buckets[b]);
+		}
+		parallel_for(threads, threads, [&](std::size_t first, std::size_t last, std::size_t) {
+			for (auto b = first; b != last; ++b)
+			{
+				const auto begin = result.order.begin() + buckets[b];
+				const auto end = result.order.begin() + buckets[b + 1];
+
+				std::sort(begin, end, [&](std::size_t lhs, std::size_t rhs) {
+					return hashes[lhs] != hashes[rhs] ? hashes[lhs] < hashes[rhs] : lhs < rhs;
+				});
+
+				// equal hashes are almost always equal keys, collisions are split stably
+				for (auto run = begin; run != end;)
+				{
+					auto run_end = run;
+					while (run_end != end && hashes[*run_end] == hashes[*run]) {
+						++run_end;
+					}
+					for (auto group = run; group != run_end;)
+					{
+						bucket_bounds[b].push_back(group - result.order.begin());
+						// taken before the partition moves the element group points at
+						const auto& key = key_of(*group);
+						group = std::stable_partition(group, run_end, [&](std::size_t i) {
+							return Equal{}(key_of(i), key);
+						});
+					}
+					run = run_end;
+				}
+			}
+		});
+
+		std::size_t groups = 0;
+		for (const auto& bounds : bucket_bounds) {
+			groups += bounds.size();
+		}
+		result.bounds.reserve(groups + 1);
+		for (const auto& bounds : bucket_bounds) {
+			result.bounds.insert(result.bounds.end(), bounds.begin(), bounds.end());
+		}
+		result.bounds.push_back(count);
+
+		return result;
+	}
+}
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef LION_GRAPH_DETAIL_VARINT_HPP
+#define LION_GRAPH_DETAIL_VARINT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+namespace lion::graph::detail
+{
+	// little endian base 128, seven bits per byte, the high bit is set on
+	// every byte but the last
+	template<typename ByteList>
+	void put_varint(ByteList& bytes, std::uint64_t value)
+	{
+		while (value >= 0x80)
+		{
+			bytes.push_back(static_cast<unsigned char>(value | 0x80));
+			value >>= 7;
+		}
+		bytes.push_back(static_cast<unsigned char>(value));
+	}
+
+	inline std::uint64_t get_varint(const unsigned char*& bytes) noexcept
+	{
+		// gaps between neighbours mostly fit one byte
+		std::uint64_t byte = *bytes++;
+		if (byte < 0x80) {
+			return byte;
+		}
+
+		std::uint64_t value = byte & 0x7f;
+		for (int shift = 7;; shift += 7)
+		{
+			byte = *bytes++;
+			value |= (byte & 0x7f) << shift;
+			if (byte < 0x80) {
+				return value;
+			}
+		}
+	}
+
+	// small negative numbers become small positive ones
+	constexpr std::uint64_t zigzag(std::int64_t value) noexcept {
+		return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+	}
+
+	constexpr std::int64_t unzigzag(std::uint64_t value) noexcept {
+		return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+	}
+
+	// a row is varint(count), zigzag(first - source) and then the gaps between
+	// the sorted ids. the first id is relative to the source because edges of
+	// well ordered graphs tend to stay close to it
+	template<typename ByteList, typename Id>
+	void put_row(ByteList& bytes, Id source, const Id* first, const Id* last)
+	{
+		put_varint(bytes, static_cast<std::uint64_t>(last - first));
+		if (first == last) {
+			return;
+		}
+
+		put_varint(bytes, zigzag(static_cast<std::int64_t>(*first) - static_cast<std::int64_t>(source)));
+		for (auto previous = first++; first != last; previous = first++) {
+			put_varint(bytes, static_cast<std::uint64_t>(*first - *previous));
+		}
+	}
+
+	inline std::size_t row_count(const unsigned char* row) noexcept {
+		return static_cast<std::size_t>(get_varint(row));
+	}
+
+	// decodes the ids of one row on the fly
+	template<typename Id>
+	class varint_iterator
+	{
+	private:
+		const unsigned char* next = nullptr;
+		std::size_t remaining = 0;
+		Id current = 0;
+
+	public:
+		using value_type		= Id;
+		using reference			= Id;
+		using pointer			= const Id*;
+		using difference_type	= std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+
+		varint_iterator() = default;
+
+		// end iterator, row_end is where the next row starts
+		explicit varint_iterator(const unsigned char* row_end) noexcept
+			: next(row_end)
+		{}
+
+		varint_iterator(const unsigned char* row, Id source) noexcept
+			: next(row)
+		{
+			remaining = static_cast<std::size_t>(get_varint(next));
+			if (remaining) {
+				current = static_cast<Id>(static_cast<std::int64_t>(source) + unzigzag(get_varint(next)));
+			}
+		}
+
+		varint_iterator& operator++() noexcept
+		{
+			if (--remaining) {
+				current += static_cast<Id>(get_varint(next));
+			}
+			return *this;
+		}
+
+		varint_iterator operator++(int) noexcept
+		{
+			varint_iterator temp(*this);
+			++*this;
+			return temp;
+		}
+
+		reference operator*() const noexcept { return current; }
+
+		friend bool operator==(const varint_iterator& lhs, const varint_iterator& rhs) {
+			return lhs.next == rhs.next && lhs.remaining == rhs.remaining;
+		}
+		friend bool operator!=(const varint_iterator& lhs, const varint_iterator& rhs) {
+			return !(lhs == rhs);
+		}
+	};
+}
+
+#endif
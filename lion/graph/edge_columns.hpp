@@ -0,0 +1,173 @@
+#ifndef LION_GRAPH_EDGE_COLUMNS_HPP
+#define LION_GRAPH_EDGE_COLUMNS_HPP
+
+#include "graph_traits.hpp"
+
+#include <type_traits>
+#include <functional>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <tuple>
+
+namespace lion::graph
+{
+	namespace detail
+	{
+		template<typename Tag, typename... Tags>
+		struct tag_index;
+
+		template<typename Tag, typename... Tags>
+		struct tag_index<Tag, Tag, Tags...> : std::integral_constant<std::size_t, 0> {};
+
+		template<typename Tag, typename First, typename... Tags>
+		struct tag_index<Tag, First, Tags...>
+			: std::integral_constant<std::size_t, 1 + tag_index<Tag, Tags...>::value>
+		{};
+	}
+
+	// reads one column of edge properties, a weight map for algorithms
+	// that take the weight of an edge id
+	template<typename T>
+	class column_weights
+	{
+	private:
+		const T* data;
+
+	public:
+		explicit column_weights(const T* column) noexcept
+			: data(column)
+		{}
+
+		const T& operator()(std::size_t edge) const noexcept { return data[edge]; }
+	};
+
+	// the weights a graph stores itself, optionally passed through a
+	// projection such as a pointer to a member of the weight type
+	template<typename Graph, typename Projection = void>
+	class graph_weights
+	{
+	private:
+		const Graph* graph;
+		Projection projection;
+
+	public:
+		graph_weights(const Graph& g, Projection p)
+			: graph(std::addressof(g)), projection(std::move(p))
+		{}
+
+		decltype(auto) operator()(std::size_t edge) const {
+			return std::invoke(projection, graph->weight(edge));
+		}
+	};
+
+	template<typename Graph>
+	class graph_weights<Graph, void>
+	{
+	private:
+		const Graph* graph;
+
+	public:
+		explicit graph_weights(const Graph& g) noexcept
+			: graph(std::addressof(g))
+		{}
+
+		decltype(auto) operator()(std::size_t edge) const { return graph->weight(edge); }
+	};
+
+	template<typename Graph>
+	graph_weights<Graph> edge_weights(const Graph& graph) {
+		return graph_weights<Graph>(graph);
+	}
+
+	template<typename Graph, typename Projection>
+	graph_weights<Graph, Projection> edge_weights(const Graph& graph, Projection projection) {
+		return graph_weights<Graph, Projection>(graph, std::move(projection));
+	}
+
+	// edge properties stored column by column and indexed by edge id, a
+	// column is named by a tag type whose value_type is the stored type:
+	//
+	//   struct travel_time { using value_type = float; };
+	//   edge_columns<travel_time, length> columns(graph.edge_bound());
+	//   columns.weights<travel_time>() then reads the travel_time array only
+	template<typename Allocator, typename... Tags>
+	class basic_edge_columns
+	{
+	public:
+		using allocator_type = Allocator;
+		using size_type		 = std::size_t;
+
+		template<typename Tag>
+		using column_type = std::vector<
+			typename Tag::value_type,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<typename Tag::value_type>
+		>;
+
+	private:
+		std::tuple<column_type<Tags>...> columns;
+		size_type count = 0;
+
+	public:
+		explicit basic_edge_columns(size_type size = 0, const allocator_type& alloc = allocator_type{})
+			: columns(column_type<Tags>(size, typename Tags::value_type{}, alloc)...), count(size)
+		{}
+
+		void resize(size_type size)
+		{
+			std::apply([size](auto&... column) { (column.resize(size), ...); }, columns);
+			count = size;
+		}
+
+		void reserve(size_type size) {
+			std::apply([size](auto&... column) { (column.reserve(size), ...); }, columns);
+		}
+
+		size_type size() const noexcept { return count; }
+
+		template<typename Tag>
+		column_type<Tag>& column() noexcept {
+			return std::get<detail::tag_index<Tag, Tags...>::value>(columns);
+		}
+
+		template<typename Tag>
+		const column_type<Tag>& column() const noexcept {
+			return std::get<detail::tag_index<Tag, Tags...>::value>(columns);
+		}
+
+		template<typename Tag>
+		typename Tag::value_type& get(std::size_t edge) noexcept { return column<Tag>()[edge]; }
+
+		template<typename Tag>
+		const typename Tag::value_type& get(std::size_t edge) const noexcept { return column<Tag>()[edge]; }
+
+		template<typename Tag>
+		column_weights<typename Tag::value_type> weights() const noexcept {
+			return column_weights<typename Tag::value_type>(column<Tag>().data());
+		}
+
+		// splits the weights of a graph with edge ids into the columns, one
+		// projection per tag, e.g. assign(graph, &route::time, &route::length)
+		template<typename Graph, typename... Projections>
+		void assign(const Graph& graph, Projections... projections)
+		{
+			static_assert(has_edge_ids_v<Graph>, "edge columns need a graph that numbers its edges");
+			static_assert(sizeof...(Projections) == sizeof...(Tags), "one projection per column");
+
+			resize(graph.edge_bound());
+			for (std::size_t edge = 0; edge < count; ++edge)
+			{
+				const auto& weight = graph.weight(edge);
+				((column<Tags>()[edge] = std::invoke(projections, weight)), ...);
+			}
+		}
+
+		allocator_type get_allocator() const { return std::get<0>(columns).get_allocator(); }
+	};
+
+	template<typename... Tags>
+	using edge_columns = basic_edge_columns<std::allocator<char>, Tags...>;
+}
+
+#endif
@@ -5,6 +5,7 @@
 #include "wdigraph.hpp"
 
 #include <type_traits>
+#include <utility>
 
 namespace lion::graph
 {
@@ -44,6 +45,117 @@ namespace lion::graph
 		static constexpr bool is_directed = std::is_same_v<Graph<Vertex, Weight, Representation, Allocator>,
 														   wdigraph<Vertex, Weight, Representation, Allocator>>;
 	};
+
+	// representations that number their vertices densely and expose
+	// id_of/key_of/id_bound/targets can be traversed with flat scratch arrays
+	template<typename Graph, typename = void>
+	struct is_indexed_graph : std::false_type {};
+
+	template<typename Graph>
+	struct is_indexed_graph<Graph, std::void_t<
+		decltype(std::declval<const Graph&>().id_bound()),
+		decltype(std::declval<const Graph&>().id_of(std::declval<const typename Graph::vertex_type&>())),
+		decltype(std::declval<const Graph&>().key_of(0)),
+		decltype(std::declval<const Graph&>().targets(0))
+	>> : std::true_type {};
+
+	template<typename Graph>
+	inline constexpr bool is_indexed_graph_v = is_indexed_graph<Graph>::value;
+
+	// indexed graphs that also list the predecessors of an id, which lets
+	// algorithms pull from in-neighbors instead of pushing to out-neighbors
+	template<typename Graph, typename = void>
+	struct is_bidirectional_graph : std::false_type {};
+
+	template<typename Graph>
+	struct is_bidirectional_graph<Graph, std::void_t<
+		decltype(std::declval<const Graph&>().sources(0))
+	>> : std::bool_constant<is_indexed_graph_v<Graph>> {};
+
+	template<typename Graph>
+	inline constexpr bool is_bidirectional_graph_v = is_bidirectional_graph<Graph>::value;
+
+	// indexed graphs whose rows a writer may replace at any time hand out
+	// row(id), whose targets() and weights() come from one read of the row
+	template<typename Graph, typename = void>
+	struct has_weighted_rows : std::false_type {};
+
+	template<typename Graph>
+	struct has_weighted_rows<Graph, std::void_t<
+		decltype(std::declval<const Graph&>().row(0).targets()),
+		decltype(std::declval<const Graph&>().row(0).weights())
+	>> : std::bool_constant<is_indexed_graph_v<Graph>> {};
+
+	template<typename Graph>
+	inline constexpr bool has_weighted_rows_v = has_weighted_rows<Graph>::value;
+
+	// indexed graphs that keep their weights apart from the targets, weights(id)
+	// runs parallel to targets(id) so weight passes never touch the ids. graphs
+	// with weighted rows count too, read them through detail::weighted_row
+	template<typename Graph, typename = void>
+	struct is_weighted_indexed_graph : std::bool_constant<has_weighted_rows_v<Graph>> {};
+
+	template<typename Graph>
+	struct is_weighted_indexed_graph<Graph, std::void_t<
+		decltype(std::declval<const Graph&>().weights(0))
+	>> : std::bool_constant<is_indexed_graph_v<Graph>> {};
+
+	template<typename Graph>
+	inline constexpr bool is_weighted_indexed_graph_v = is_weighted_indexed_graph<Graph>::value;
+
+	namespace detail
+	{
+		template<typename Targets, typename Weights>
+		struct split_row
+		{
+			Targets row_targets;
+			Weights row_weights;
+
+			Targets targets() const noexcept { return row_targets; }
+			Weights weights() const noexcept { return row_weights; }
+		};
+
+		// targets() and weights() of one row of a weighted indexed graph,
+		// through row(id) where the graph has it
+		template<typename Graph, typename Id>
+		auto weighted_row(const Graph& graph, Id id)
+		{
+			if constexpr (has_weighted_rows_v<Graph>) {
+				return graph.row(id);
+			}
+			else {
+				return split_row<decltype(graph.targets(id)), decltype(graph.weights(id))>{ graph.targets(id), graph.weights(id) };
+			}
+		}
+	}
+
+	// indexed graphs that number their edges, the edges of a row are
+	// first_edge(id), first_edge(id) + 1, ... in targets(id) order, so edge
+	// properties can live in plain arrays indexed by edge id
+	template<typename Graph, typename = void>
+	struct has_edge_ids : std::false_type {};
+
+	template<typename Graph>
+	struct has_edge_ids<Graph, std::void_t<
+		decltype(std::declval<const Graph&>().first_edge(0)),
+		decltype(std::declval<const Graph&>().edge_bound())
+	>> : std::bool_constant<is_indexed_graph_v<Graph>> {};
+
+	template<typename Graph>
+	inline constexpr bool has_edge_ids_v = has_edge_ids<Graph>::value;
+
+	// graphs that can report whether every row of targets is ordered by id,
+	// ordered rows can be intersected by a merge without copying them first
+	template<typename Graph, typename = void>
+	struct has_sorted_rows : std::false_type {};
+
+	template<typename Graph>
+	struct has_sorted_rows<Graph, std::void_t<
+		decltype(std::declval<const Graph&>().rows_sorted())
+	>> : std::bool_constant<is_indexed_graph_v<Graph>> {};
+
+	template<typename Graph>
+	inline constexpr bool has_sorted_rows_v = has_sorted_rows<Graph>::value;
 }
 
 #endif
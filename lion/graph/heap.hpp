@@ -0,0 +1,265 @@
+#ifndef LION_GRAPH_HEAP_HPP
+#define LION_GRAPH_HEAP_HPP
+
+#include <type_traits>
+#include <algorithm>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace lion::graph
+{
+	// priority queues of ids keyed by distance for the shortest path
+	// algorithms, all with the same face:
+	//
+	//   reserve(bound)  ids will be in [0, bound)
+	//   push(id, key)   inserts id or lowers its key
+	//   pop()           removes and returns { key, id } with the least key
+	//   empty(), clear()
+	//
+	// the lazy heaps keep every push and may pop an id again with a stale
+	// key, callers skip ids they already settled
+
+	// binary heap with lazy deletion, the cheapest per operation when
+	// decreases are rare
+	template<typename Id, typename Key, typename Allocator = std::allocator<Id>>
+	class binary_heap
+	{
+	public:
+		using entry_type = std::pair<Key, Id>;
+
+	private:
+		std::vector<entry_type, typename std::allocator_traits<Allocator>::template rebind_alloc<entry_type>> entries;
+
+	public:
+		explicit binary_heap(const Allocator& alloc = Allocator{})
+			: entries(alloc)
+		{}
+
+		void reserve(std::size_t) noexcept {}
+
+		bool empty() const noexcept { return entries.empty(); }
+		std::size_t size() const noexcept { return entries.size(); }
+
+		void push(Id id, const Key& key)
+		{
+			entries.emplace_back(key, id);
+			std::push_heap(entries.begin(), entries.end(), std::greater<entry_type>{});
+		}
+
+		entry_type pop()
+		{
+			std::pop_heap(entries.begin(), entries.end(), std::greater<entry_type>{});
+			entry_type top = entries.back();
+			entries.pop_back();
+			return top;
+		}
+
+		void clear() noexcept { entries.clear(); }
+	};
+
+	// d-ary heap that holds every id at most once and lowers keys in place,
+	// a wider node makes the tree shallower for sift up at the price of more
+	// comparisons on the way down
+	template<typename Id, typename Key, typename Allocator = std::allocator<Id>, std::size_t Arity = 4>
+	class dary_heap
+	{
+		static_assert(Arity >= 2, "a heap node needs at least two children");
+
+	public:
+		using entry_type = std::pair<Key, Id>;
+
+	private:
+		static constexpr std::size_t absent = static_cast<std::size_t>(-1);
+
+		std::vector<entry_type, typename std::allocator_traits<Allocator>::template rebind_alloc<entry_type>> entries;
+		std::vector<std::size_t, typename std::allocator_traits<Allocator>::template rebind_alloc<std::size_t>> positions;
+
+		void place(std::size_t index, const entry_type& entry)
+		{
+			entries[index] = entry;
+			positions[static_cast<std::size_t>(entry.second)] = index;
+		}
+
+		void sift_up(std::size_t index, entry_type entry)
+		{
+			while (index != 0)
+			{
+				const std::size_t parent = (index - 1) / Arity;
+				if (!(entry.first < entries[parent].first)) {
+					break;
+				}
+				place(index, entries[parent]);
+				index = parent;
+			}
+			place(index, entry);
+		}
+
+		void sift_down(std::size_t index, entry_type entry)
+		{
+			const std::size_t count = entries.size();
+			for (;;)
+			{
+				const std::size_t first = index * Arity + 1;
+				if (first >= count) {
+					break;
+				}
+
+				const std::size_t last = std::min(first + Arity, count);
+				std::size_t least = first;
+				for (std::size_t child = first + 1; child < last; ++child)
+				{
+					if (entries[child].first < entries[least].first) {
+						least = child;
+					}
+				}
+				if (!(entries[least].first < entry.first)) {
+					break;
+				}
+				place(index, entries[least]);
+				index = least;
+			}
+			place(index, entry);
+		}
+
+	public:
+		explicit dary_heap(const Allocator& alloc = Allocator{})
+			: entries(alloc), positions(alloc)
+		{}
+
+		void reserve(std::size_t bound)
+		{
+			if (positions.size() < bound) {
+				positions.resize(bound, absent);
+			}
+		}
+
+		bool empty() const noexcept { return entries.empty(); }
+		std::size_t size() const noexcept { return entries.size(); }
+
+		bool contains(Id id) const noexcept { return positions[static_cast<std::size_t>(id)] != absent; }
+
+		void push(Id id, const Key& key)
+		{
+			const std::size_t position = positions[static_cast<std::size_t>(id)];
+			if (position == absent)
+			{
+				entries.emplace_back();
+				sift_up(entries.size() - 1, entry_type(key, id));
+			}
+			else if (key < entries[position].first) {
+				sift_up(position, entry_type(key, id));
+			}
+		}
+
+		entry_type pop()
+		{
+			const entry_type top = entries.front();
+			positions[static_cast<std::size_t>(top.second)] = absent;
+
+			const entry_type last = entries.back();
+			entries.pop_back();
+			if (!entries.empty()) {
+				sift_down(0, last);
+			}
+			return top;
+		}
+
+		// only the ids still queued are touched, so clearing after a short
+		// query costs as little as the query did
+		void clear() noexcept
+		{
+			for (const auto& entry : entries) {
+				positions[static_cast<std::size_t>(entry.second)] = absent;
+			}
+			entries.clear();
+		}
+	};
+
+	// monotone radix heap for unsigned integer keys. keys popped never
+	// decrease, so every key shares a prefix with the last one popped and
+	// goes to the bucket of the highest bit it differs in; a pop empties the
+	// first non-empty bucket into lower ones. lazy like binary_heap
+	template<typename Id, typename Key, typename Allocator = std::allocator<Id>>
+	class radix_heap
+	{
+		static_assert(std::is_integral_v<Key> && std::is_unsigned_v<Key>, "radix_heap needs unsigned integer keys");
+
+	public:
+		using entry_type = std::pair<Key, Id>;
+
+	private:
+		static constexpr std::size_t bucket_count = std::numeric_limits<Key>::digits + 1;
+
+		using bucket_type = std::vector<entry_type, typename std::allocator_traits<Allocator>::template rebind_alloc<entry_type>>;
+
+		bucket_type buckets[bucket_count];
+		Key last = 0;
+		std::size_t count = 0;
+
+		static std::size_t bucket_of(Key key, Key from) noexcept
+		{
+			std::size_t bits = 0;
+			for (Key differ = key ^ from; differ; differ >>= 1) {
+				++bits;
+			}
+			return bits;
+		}
+
+	public:
+		explicit radix_heap(const Allocator& = Allocator{}) {}
+
+		void reserve(std::size_t) noexcept {}
+
+		bool empty() const noexcept { return count == 0; }
+		std::size_t size() const noexcept { return count; }
+
+		// key must not be below the last key popped
+		void push(Id id, const Key& key)
+		{
+			buckets[bucket_of(key, last)].emplace_back(key, id);
+			++count;
+		}
+
+		entry_type pop()
+		{
+			if (buckets[0].empty())
+			{
+				std::size_t index = 1;
+				while (buckets[index].empty()) {
+					++index;
+				}
+
+				auto& bucket = buckets[index];
+				last = std::min_element(bucket.begin(), bucket.end())->first;
+				for (const auto& entry : bucket) {
+					buckets[bucket_of(entry.first, last)].push_back(entry);
+				}
+				bucket.clear();
+			}
+
+			const entry_type top = buckets[0].back();
+			buckets[0].pop_back();
+			--count;
+			return top;
+		}
+
+		void clear() noexcept
+		{
+			for (auto& bucket : buckets) {
+				bucket.clear();
+			}
+			last = 0;
+			count = 0;
+		}
+	};
+
+	template<typename Id, typename Key, typename Allocator = std::allocator<Id>>
+	using quaternary_heap = dary_heap<Id, Key, Allocator, 4>;
+}
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef LION_GRAPH_MAPPED_HPP
+#define LION_GRAPH_MAPPED_HPP
+
+#include "mapped/mapped_file.hpp"
+#include "mapped/mapped_format.hpp"
+#include "mapped/mapped_storage.hpp"
+#include "mapped/mapped_digraph.hpp"
+#include "mapped/mapped_wdigraph.hpp"
+#include "mapped/mapped_edge_iterator.hpp"
+#include "mapped/mapped_writer.hpp"
+
+#endif
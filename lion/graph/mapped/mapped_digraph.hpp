@@ -0,0 +1,67 @@
+#ifndef LION_GRAPH_MAPPED_DIGRAPH_HPP
+#define LION_GRAPH_MAPPED_DIGRAPH_HPP
+
+#include "../../range.hpp"
+#include "mapped_storage.hpp"
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <algorithm>
+
+namespace lion::graph
+{
+	// read-only digraph served from a file written by write_mapped(),
+	// string keys come back as string views into the mapping
+	template<typename Vertex>
+	class mapped_digraph : public detail::mapped_storage<Vertex>
+	{
+	private:
+		using storage_type = detail::mapped_storage<Vertex>;
+
+	public:
+		using vertex_type	  = typename storage_type::vertex_type;
+		using allocator_type  = typename storage_type::allocator_type;
+		using size_type		  = typename storage_type::size_type;
+		using difference_type = typename storage_type::difference_type;
+
+		using vertex_iterator = typename storage_type::vertex_iterator;
+		class edge_iterator;
+
+		mapped_digraph() = default;
+
+		explicit mapped_digraph(const std::string& path) {
+			open(path);
+		}
+
+		bool open(const std::string& path) {
+			return storage_type::open(path, 0);
+		}
+
+		size_type adjacent(const vertex_type& x, const vertex_type& y) const
+		{
+			const auto row = this->targets(this->id_of(x));
+			return std::count(row.begin(), row.end(), this->id_of(y));
+		}
+
+		using storage_type::begin;
+		using storage_type::end;
+
+		edge_iterator begin(const vertex_type& vert) const noexcept {
+			return edge_iterator(this->targets(this->id_of(vert)).begin(), *this);
+		}
+		edge_iterator end(const vertex_type& vert) const noexcept {
+			return edge_iterator(this->targets(this->id_of(vert)).end(), *this);
+		}
+
+		range<edge_iterator> edges(const vertex_type& vert) const noexcept {
+			return { begin(vert), end(vert) };
+		}
+
+		void swap(mapped_digraph& rhs) noexcept {
+			storage_type::swap(rhs);
+		}
+	};
+}
+
+#endif
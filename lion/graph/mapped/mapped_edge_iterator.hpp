@@ -0,0 +1,134 @@
+#ifndef LION_GRAPH_MAPPED_EDGE_ITERATOR_HPP
+#define LION_GRAPH_MAPPED_EDGE_ITERATOR_HPP
+
+#include "mapped_digraph.hpp"
+#include "mapped_wdigraph.hpp"
+
+#include <iterator>
+#include <memory>
+
+namespace lion::graph
+{
+	// unweighted
+	template<typename Vertex>
+	class mapped_digraph<Vertex>::edge_iterator
+	{
+	private:
+		friend class mapped_digraph;
+
+		using graph = mapped_digraph<Vertex>;
+
+		const vertex_id* current = nullptr;
+		const graph* owner = nullptr;
+
+		edge_iterator(const vertex_id* curr, const graph& g)
+			: current(curr), owner(std::addressof(g))
+		{}
+
+	public:
+		using value_type		= typename graph::vertex_type;
+		using reference			= decltype(std::declval<const graph&>().key_of(0));
+		using difference_type	= std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+
+		struct pointer
+		{
+			value_type value;
+			const value_type* operator->() const { return std::addressof(value); }
+		};
+
+		edge_iterator() = default;
+		edge_iterator(const edge_iterator&) = default;
+		edge_iterator& operator=(const edge_iterator&) = default;
+
+		edge_iterator& operator++()
+		{
+			++current;
+			return *this;
+		}
+
+		edge_iterator operator++(int)
+		{
+			edge_iterator temp(*this);
+			++current;
+			return temp;
+		}
+
+		reference operator*() const { return owner->key_of(*current); }
+		pointer operator->()  const { return { operator*() }; }
+
+		friend bool operator==(const edge_iterator& lhs, const edge_iterator& rhs) {
+			return lhs.current == rhs.current;
+		}
+		friend bool operator!=(const edge_iterator& lhs, const edge_iterator& rhs) {
+			return !(lhs == rhs);
+		}
+	};
+
+	// weighted
+	template<typename Vertex, typename Weight>
+	class mapped_wdigraph<Vertex, Weight>::edge_iterator
+	{
+	private:
+		friend class mapped_wdigraph;
+
+		using graph = mapped_wdigraph<Vertex, Weight>;
+
+		const vertex_id* current = nullptr;
+		const typename graph::weight_type* weight = nullptr;
+		const graph* owner = nullptr;
+
+		edge_iterator(const vertex_id* curr, decltype(weight) w, const graph& g)
+			: current(curr), weight(w), owner(std::addressof(g))
+		{}
+
+	public:
+		struct value_type
+		{
+			typename graph::vertex_type second;
+			const typename graph::weight_type& weight;
+
+			operator const typename graph::vertex_type&() const { return second; }
+		};
+
+		struct pointer
+		{
+			value_type value;
+			const value_type* operator->() const { return std::addressof(value); }
+		};
+
+		using reference			= value_type;
+		using difference_type	= std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+
+		edge_iterator() = default;
+		edge_iterator(const edge_iterator&) = default;
+		edge_iterator& operator=(const edge_iterator&) = default;
+
+		edge_iterator& operator++()
+		{
+			++current;
+			++weight;
+			return *this;
+		}
+
+		edge_iterator operator++(int)
+		{
+			edge_iterator temp(*this);
+			++*this;
+			return temp;
+		}
+
+		reference operator*() const { return { owner->key_of(*current), *weight }; }
+		pointer operator->()  const { return { operator*() }; }
+
+		friend bool operator==(const edge_iterator& lhs, const edge_iterator& rhs) {
+			return lhs.current == rhs.current;
+		}
+		friend bool operator!=(const edge_iterator& lhs, const edge_iterator& rhs) {
+			return !(lhs == rhs);
+		}
+	};
+}
+
+#endif
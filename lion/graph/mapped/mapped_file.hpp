@@ -0,0 +1,136 @@
+#ifndef LION_GRAPH_MAPPED_FILE_HPP
+#define LION_GRAPH_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace lion::graph::detail
+{
+	// read-only mapping of a whole file, pages are shared through the page
+	// cache with every other process that maps the same file
+	class mapped_file
+	{
+	private:
+		const unsigned char* bytes = nullptr;
+		std::size_t length = 0;
+
+	public:
+		mapped_file() = default;
+		mapped_file(const mapped_file&) = delete;
+		mapped_file& operator=(const mapped_file&) = delete;
+
+		mapped_file(mapped_file&& rhs) noexcept
+			: bytes(std::exchange(rhs.bytes, nullptr)), length(std::exchange(rhs.length, 0))
+		{}
+
+		mapped_file& operator=(mapped_file&& rhs) noexcept
+		{
+			if (this != &rhs)
+			{
+				close();
+				bytes = std::exchange(rhs.bytes, nullptr);
+				length = std::exchange(rhs.length, 0);
+			}
+			return *this;
+		}
+
+		~mapped_file() { close(); }
+
+		bool open(const char* path)
+		{
+			close();
+#ifdef _WIN32
+			const HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr,
+				OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (file == INVALID_HANDLE_VALUE) {
+				return false;
+			}
+
+			LARGE_INTEGER size;
+			if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+			{
+				CloseHandle(file);
+				return false;
+			}
+
+			// the view keeps the mapping and the file alive on its own
+			const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			CloseHandle(file);
+			if (!mapping) {
+				return false;
+			}
+
+			const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			CloseHandle(mapping);
+			if (!view) {
+				return false;
+			}
+
+			bytes = static_cast<const unsigned char*>(view);
+			length = static_cast<std::size_t>(size.QuadPart);
+#else
+			const int fd = ::open(path, O_RDONLY);
+			if (fd < 0) {
+				return false;
+			}
+
+			struct stat info;
+			if (::fstat(fd, &info) != 0 || info.st_size == 0)
+			{
+				::close(fd);
+				return false;
+			}
+
+			// the mapping outlives the descriptor
+			void* view = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+			::close(fd);
+			if (view == MAP_FAILED) {
+				return false;
+			}
+
+			bytes = static_cast<const unsigned char*>(view);
+			length = static_cast<std::size_t>(info.st_size);
+#endif
+			return true;
+		}
+
+		void close() noexcept
+		{
+			if (!bytes) {
+				return;
+			}
+#ifdef _WIN32
+			UnmapViewOfFile(bytes);
+#else
+			::munmap(const_cast<unsigned char*>(bytes), length);
+#endif
+			bytes = nullptr;
+			length = 0;
+		}
+
+		bool is_open() const noexcept { return bytes != nullptr; }
+
+		const unsigned char* data() const noexcept { return bytes; }
+		std::size_t size() const noexcept { return length; }
+
+		void swap(mapped_file& rhs) noexcept
+		{
+			std::swap(bytes, rhs.bytes);
+			std::swap(length, rhs.length);
+		}
+	};
+}
+
+#endif
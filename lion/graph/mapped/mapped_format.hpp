@@ -0,0 +1,95 @@
+#ifndef LION_GRAPH_MAPPED_FORMAT_HPP
+#define LION_GRAPH_MAPPED_FORMAT_HPP
+
+#include "../vertex_interner.hpp"
+
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace lion::graph::detail
+{
+	// on-disk layout, all integers in the writer's byte order:
+	//
+	//   mapped_header
+	//   keys         fixed size keys, or the characters of all string keys
+	//   key_offsets  string keys only, vertex_count + 1 character offsets into keys
+	//   index        vertex ids ordered by key, binary searched by id_of
+	//   offsets      vertex_count + 1 uint64 edge offsets
+	//   targets      edge_count vertex ids
+	//   weights      edge_count weights, weighted files only
+	//
+	// every section starts on a mapped_alignment boundary
+	inline constexpr char mapped_magic[8] = { 'L', 'I', 'O', 'N', 'G', 'R', 'P', 'H' };
+	inline constexpr std::uint32_t mapped_version = 1;
+	inline constexpr std::uint32_t mapped_byte_order = 0x01020304;
+	inline constexpr std::size_t mapped_alignment = 8;
+
+	struct mapped_header
+	{
+		char magic[8];
+		std::uint32_t version;
+		std::uint32_t byte_order;
+		std::uint32_t key_size;		// bytes per key, bytes per character for string keys
+		std::uint32_t string_keys;
+		std::uint32_t weight_size;	// 0 for unweighted files
+		std::uint32_t id_size;
+		std::uint64_t vertex_count;
+		std::uint64_t edge_count;
+		std::uint64_t keys;
+		std::uint64_t key_offsets;
+		std::uint64_t index;
+		std::uint64_t offsets;
+		std::uint64_t targets;
+		std::uint64_t weights;
+		std::uint64_t file_size;
+	};
+
+	constexpr std::uint64_t mapped_align(std::uint64_t offset) noexcept {
+		return (offset + mapped_alignment - 1) / mapped_alignment * mapped_alignment;
+	}
+
+	// how a key type is stored, fixed size keys are copied bytewise
+	template<typename Vertex>
+	struct mapped_key
+	{
+		static_assert(std::is_trivially_copyable_v<Vertex>, "mapped keys must be trivially copyable or strings");
+		static_assert(alignof(Vertex) <= mapped_alignment, "mapped keys must not be over-aligned");
+
+		using value_type = Vertex;
+		using reference	 = const Vertex&;
+
+		static constexpr bool is_string = false;
+		static constexpr std::uint32_t size = sizeof(Vertex);
+
+		static reference get(const unsigned char* keys, const std::uint64_t*, std::size_t id) noexcept {
+			return reinterpret_cast<const Vertex*>(keys)[id];
+		}
+	};
+
+	// string keys are served as views into the mapping
+	template<typename Char, typename Traits, typename Allocator>
+	struct mapped_key<std::basic_string<Char, Traits, Allocator>>
+	{
+		using value_type = std::basic_string_view<Char, Traits>;
+		using reference	 = value_type;
+
+		static constexpr bool is_string = true;
+		static constexpr std::uint32_t size = sizeof(Char);
+
+		static reference get(const unsigned char* keys, const std::uint64_t* offsets, std::size_t id) noexcept
+		{
+			return value_type(reinterpret_cast<const Char*>(keys) + offsets[id],
+				static_cast<std::size_t>(offsets[id + 1] - offsets[id]));
+		}
+	};
+
+	template<typename Char, typename Traits>
+	struct mapped_key<std::basic_string_view<Char, Traits>>
+		: mapped_key<std::basic_string<Char, Traits>>
+	{};
+}
+
+#endif
@@ -0,0 +1,263 @@
+#ifndef LION_GRAPH_MAPPED_STORAGE_HPP
+#define LION_GRAPH_MAPPED_STORAGE_HPP
+
+#include "../../range.hpp"
+#include "../vertex_interner.hpp"
+#include "mapped_file.hpp"
+#include "mapped_format.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+
+namespace lion::graph::detail
+{
+	// the parts of a mapped graph that do not depend on weights, everything
+	// is read straight out of the mapping and nothing is copied on open
+	template<typename Vertex>
+	class mapped_storage
+	{
+	protected:
+		using key_traits = mapped_key<Vertex>;
+
+	public:
+		using vertex_type	  = typename key_traits::value_type;
+		using allocator_type  = std::allocator<vertex_type>;
+		using size_type		  = std::size_t;
+		using difference_type = std::ptrdiff_t;
+
+		class vertex_iterator;
+
+		static constexpr vertex_id npos = static_cast<vertex_id>(-1);
+
+	protected:
+		mapped_file file;
+		const mapped_header* header = nullptr;
+		const unsigned char* keys = nullptr;
+		const std::uint64_t* key_offsets = nullptr;
+		const vertex_id* index = nullptr;
+		const std::uint64_t* offsets = nullptr;
+		const vertex_id* columns = nullptr;
+		const unsigned char* weight_data = nullptr;
+
+		mapped_storage() = default;
+		mapped_storage(const mapped_storage&) = delete;
+		mapped_storage& operator=(const mapped_storage&) = delete;
+
+		mapped_storage(mapped_storage&& rhs) noexcept {
+			swap(rhs);
+		}
+
+		mapped_storage& operator=(mapped_storage&& rhs) noexcept
+		{
+			close();
+			swap(rhs);
+			return *this;
+		}
+
+		~mapped_storage() = default;
+
+		// null unless count items of unit bytes starting at offset lie inside the file
+		const unsigned char* section(std::uint64_t offset, std::uint64_t count, std::uint64_t unit) const noexcept
+		{
+			const auto size = file.size();
+			if (offset % mapped_alignment != 0 || offset > size) {
+				return nullptr;
+			}
+			if (unit != 0 && count > (size - offset) / unit) {
+				return nullptr;
+			}
+			return file.data() + offset;
+		}
+
+		// only the header and the section bounds are checked so opening stays
+		// independent of the graph size, rows are trusted to hold valid ids
+		bool open(const std::string& path, std::uint32_t weight_size)
+		{
+			close();
+			if (!file.open(path.c_str()) || file.size() < sizeof(mapped_header))
+			{
+				close();
+				return false;
+			}
+
+			header = reinterpret_cast<const mapped_header*>(file.data());
+
+			const auto n = header->vertex_count;
+			const auto m = header->edge_count;
+
+			const bool valid =
+				std::memcmp(header->magic, mapped_magic, sizeof(mapped_magic)) == 0 &&
+				header->version == mapped_version &&
+				header->byte_order == mapped_byte_order &&
+				header->key_size == key_traits::size &&
+				header->string_keys == std::uint32_t(key_traits::is_string) &&
+				header->weight_size == weight_size &&
+				header->id_size == sizeof(vertex_id) &&
+				header->file_size == file.size() &&
+				n < npos;
+
+			if (!valid)
+			{
+				close();
+				return false;
+			}
+
+			auto key_count = n;
+			if constexpr (key_traits::is_string)
+			{
+				key_offsets = reinterpret_cast<const std::uint64_t*>(section(header->key_offsets, n + 1, sizeof(std::uint64_t)));
+				key_count = key_offsets ? key_offsets[n] : 0;
+			}
+			keys = section(header->keys, key_count, key_traits::size);
+			index = reinterpret_cast<const vertex_id*>(section(header->index, n, sizeof(vertex_id)));
+			offsets = reinterpret_cast<const std::uint64_t*>(section(header->offsets, n + 1, sizeof(std::uint64_t)));
+			columns = reinterpret_cast<const vertex_id*>(section(header->targets, m, sizeof(vertex_id)));
+			weight_data = weight_size ? section(header->weights, m, weight_size) : nullptr;
+
+			if (!keys || !index || !offsets || !columns || (key_traits::is_string && !key_offsets) ||
+				(weight_size && !weight_data) || offsets[0] != 0 || offsets[n] != m)
+			{
+				close();
+				return false;
+			}
+			return true;
+		}
+
+	public:
+		void close() noexcept
+		{
+			file.close();
+			header = nullptr;
+			keys = nullptr;
+			key_offsets = nullptr;
+			index = nullptr;
+			offsets = nullptr;
+			columns = nullptr;
+			weight_data = nullptr;
+		}
+
+		bool is_open() const noexcept { return header != nullptr; }
+
+		size_type vertex_count() const noexcept { return header ? header->vertex_count : 0; }
+		size_type edge_count() const noexcept { return header ? header->edge_count : 0; }
+
+		// binary search over the key-ordered index, npos if absent
+		vertex_id id_of(const vertex_type& vertex) const
+		{
+			const auto last = index + vertex_count();
+			const auto find = std::lower_bound(index, last, vertex, [this](vertex_id id, const vertex_type& key) {
+				return std::less<vertex_type>{}(key_of(id), key);
+			});
+			return find != last && !std::less<vertex_type>{}(vertex, key_of(*find)) ? *find : npos;
+		}
+
+		typename key_traits::reference key_of(vertex_id id) const noexcept {
+			return key_traits::get(keys, key_offsets, id);
+		}
+
+		size_type id_bound() const noexcept { return vertex_count(); }
+
+		range<const vertex_id*> targets(vertex_id id) const noexcept {
+			return { columns + offsets[id], columns + offsets[id + 1] };
+		}
+
+		// edge ids are positions in the targets section, consecutive per row
+		std::size_t first_edge(vertex_id id) const noexcept { return static_cast<std::size_t>(offsets[id]); }
+		std::size_t edge_bound() const noexcept { return edge_count(); }
+		vertex_id target(std::size_t edge) const noexcept { return columns[edge]; }
+
+		size_type degree(const vertex_type& vertex) const
+		{
+			const auto id = id_of(vertex);
+			return static_cast<size_type>(offsets[id + 1] - offsets[id]);
+		}
+
+		bool contains(const vertex_type& vertex) const {
+			return id_of(vertex) != npos;
+		}
+
+		vertex_iterator begin() const noexcept { return vertex_iterator(*this, 0); }
+		vertex_iterator end()   const noexcept { return vertex_iterator(*this, vertex_count()); }
+
+		range<vertex_iterator> vertices() const noexcept {
+			return { begin(), end() };
+		}
+
+		void swap(mapped_storage& rhs) noexcept
+		{
+			file.swap(rhs.file);
+			std::swap(header, rhs.header);
+			std::swap(keys, rhs.keys);
+			std::swap(key_offsets, rhs.key_offsets);
+			std::swap(index, rhs.index);
+			std::swap(offsets, rhs.offsets);
+			std::swap(columns, rhs.columns);
+			std::swap(weight_data, rhs.weight_data);
+		}
+	};
+
+	// visits the vertices in id order
+	template<typename Vertex>
+	class mapped_storage<Vertex>::vertex_iterator
+	{
+	private:
+		friend class mapped_storage;
+
+		const mapped_storage* storage = nullptr;
+		std::size_t current = 0;
+
+		vertex_iterator(const mapped_storage& s, std::size_t id)
+			: storage(std::addressof(s)), current(id)
+		{}
+
+	public:
+		using value_type		= typename mapped_storage::vertex_type;
+		using reference			= typename mapped_storage::key_traits::reference;
+		using difference_type	= std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+
+		struct pointer
+		{
+			value_type value;
+			const value_type* operator->() const { return std::addressof(value); }
+		};
+
+		vertex_iterator() = default;
+		vertex_iterator(const vertex_iterator&) = default;
+		vertex_iterator& operator=(const vertex_iterator&) = default;
+
+		vertex_iterator& operator++()
+		{
+			++current;
+			return *this;
+		}
+
+		vertex_iterator operator++(int)
+		{
+			vertex_iterator temp(*this);
+			++current;
+			return temp;
+		}
+
+		reference operator*() const { return storage->key_of(static_cast<vertex_id>(current)); }
+		pointer operator->()  const { return { operator*() }; }
+
+		vertex_id id() const noexcept { return static_cast<vertex_id>(current); }
+
+		friend bool operator==(const vertex_iterator& lhs, const vertex_iterator& rhs) {
+			return lhs.current == rhs.current;
+		}
+		friend bool operator!=(const vertex_iterator& lhs, const vertex_iterator& rhs) {
+			return !(lhs == rhs);
+		}
+	};
+}
+
+#endif
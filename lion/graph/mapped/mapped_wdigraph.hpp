@@ -0,0 +1,102 @@
+#ifndef LION_GRAPH_MAPPED_WDIGRAPH_HPP
+#define LION_GRAPH_MAPPED_WDIGRAPH_HPP
+
+#include "../../range.hpp"
+#include "mapped_storage.hpp"
+
+#include <type_traits>
+#include <cstddef>
+#include <string>
+#include <utility>
+
+namespace lion::graph
+{
+	// read-only weighted digraph served from a file written by write_mapped(),
+	// weights sit in their own section parallel to the targets
+	template<typename Vertex, typename Weight>
+	class mapped_wdigraph : public detail::mapped_storage<Vertex>
+	{
+		static_assert(std::is_trivially_copyable_v<Weight>, "mapped weights must be trivially copyable");
+		static_assert(alignof(Weight) <= detail::mapped_alignment, "mapped weights must not be over-aligned");
+
+	private:
+		using storage_type = detail::mapped_storage<Vertex>;
+
+	public:
+		using vertex_type	  = typename storage_type::vertex_type;
+		using weight_type	  = Weight;
+		using allocator_type  = typename storage_type::allocator_type;
+		using size_type		  = typename storage_type::size_type;
+		using difference_type = typename storage_type::difference_type;
+
+		using vertex_iterator = typename storage_type::vertex_iterator;
+		class edge_iterator;
+
+		mapped_wdigraph() = default;
+
+		explicit mapped_wdigraph(const std::string& path) {
+			open(path);
+		}
+
+		bool open(const std::string& path) {
+			return storage_type::open(path, sizeof(weight_type));
+		}
+
+		// weights of the edges of id, in the order of targets(id)
+		range<const weight_type*> weights(vertex_id id) const noexcept
+		{
+			const auto first = reinterpret_cast<const weight_type*>(this->weight_data);
+			return { first + this->offsets[id], first + this->offsets[id + 1] };
+		}
+
+		const weight_type& weight(std::size_t edge) const noexcept {
+			return reinterpret_cast<const weight_type*>(this->weight_data)[edge];
+		}
+
+		// weight, if given, receives the weight of the last matching edge
+		size_type adjacent(const vertex_type& x, const vertex_type& y, weight_type* weight) const
+		{
+			const auto idx = this->id_of(x);
+			const auto idy = this->id_of(y);
+
+			size_type result = 0;
+			auto w = weights(idx).begin();
+			for (const auto target : this->targets(idx))
+			{
+				if (target == idy)
+				{
+					if (weight) {
+						*weight = *w;
+					}
+					++result;
+				}
+				++w;
+			}
+			return result;
+		}
+
+		using storage_type::begin;
+		using storage_type::end;
+
+		edge_iterator begin(const vertex_type& vert) const noexcept
+		{
+			const auto id = this->id_of(vert);
+			return edge_iterator(this->targets(id).begin(), weights(id).begin(), *this);
+		}
+		edge_iterator end(const vertex_type& vert) const noexcept
+		{
+			const auto id = this->id_of(vert);
+			return edge_iterator(this->targets(id).end(), weights(id).end(), *this);
+		}
+
+		range<edge_iterator> edges(const vertex_type& vert) const noexcept {
+			return { begin(vert), end(vert) };
+		}
+
+		void swap(mapped_wdigraph& rhs) noexcept {
+			storage_type::swap(rhs);
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,185 @@
+#ifndef LION_GRAPH_MAPPED_WRITER_HPP
+#define LION_GRAPH_MAPPED_WRITER_HPP
+
+#include "../vertex_interner.hpp"
+#include "mapped_format.hpp"
+
+#include <type_traits>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+
+namespace lion::graph
+{
+	namespace detail
+	{
+		template<typename Graph, typename = void>
+		struct mapped_weight
+		{
+			using type = char;
+
+			static constexpr std::uint32_t size = 0;
+		};
+
+		template<typename Graph>
+		struct mapped_weight<Graph, std::void_t<typename Graph::weight_type>>
+		{
+			using type = typename Graph::weight_type;
+
+			static_assert(std::is_trivially_copyable_v<type>, "mapped weights must be trivially copyable");
+			static constexpr std::uint32_t size = sizeof(type);
+		};
+	}
+
+	// writes any graph in the format read by mapped_digraph/mapped_wdigraph,
+	// ids follow the order of graph.vertices()
+	template<typename Graph>
+	bool write_mapped(const Graph& graph, const std::string& path)
+	{
+		using vertex_type = typename Graph::vertex_type;
+		using key_traits = detail::mapped_key<vertex_type>;
+		using weight_traits = detail::mapped_weight<Graph>;
+
+		constexpr bool weighted = weight_traits::size != 0;
+
+		std::unordered_map<vertex_type, vertex_id> ids;
+		std::vector<const vertex_type*> keys;
+		for (const auto& vertex : graph.vertices())
+		{
+			auto&&[iter, succ] = ids.emplace(vertex, static_cast<vertex_id>(keys.size()));
+			if (succ) {
+				keys.push_back(std::addressof(iter->first));
+			}
+		}
+		if (keys.size() >= static_cast<std::size_t>(static_cast<vertex_id>(-1))) {
+			return false;
+		}
+
+		std::vector<std::uint64_t> offsets;
+		std::vector<vertex_id> targets;
+		std::vector<typename weight_traits::type> weights;
+
+		offsets.reserve(keys.size() + 1);
+		offsets.push_back(0);
+		for (const auto key : keys)
+		{
+			for (const auto& edge : graph.edges(*key))
+			{
+				const vertex_type* target;
+				if constexpr (weighted)
+				{
+					target = std::addressof(static_cast<const vertex_type&>(edge.second));
+					weights.push_back(edge.weight);
+				}
+				else {
+					target = std::addressof(static_cast<const vertex_type&>(edge));
+				}
+
+				const auto find = ids.find(*target);
+				if (find == ids.end()) {
+					return false;
+				}
+				targets.push_back(find->second);
+			}
+			offsets.push_back(targets.size());
+		}
+
+		std::vector<vertex_id> index(keys.size());
+		std::iota(index.begin(), index.end(), vertex_id(0));
+		std::sort(index.begin(), index.end(), [&](vertex_id lhs, vertex_id rhs) {
+			return std::less<vertex_type>{}(*keys[lhs], *keys[rhs]);
+		});
+
+		std::vector<std::uint64_t> key_offsets;
+		std::uint64_t key_bytes = keys.size() * key_traits::size;
+		if constexpr (key_traits::is_string)
+		{
+			key_offsets.reserve(keys.size() + 1);
+			key_offsets.push_back(0);
+			for (const auto key : keys) {
+				key_offsets.push_back(key_offsets.back() + key->size());
+			}
+			key_bytes = key_offsets.back() * key_traits::size;
+		}
+
+		detail::mapped_header header{};
+		std::memcpy(header.magic, detail::mapped_magic, sizeof(header.magic));
+		header.version = detail::mapped_version;
+		header.byte_order = detail::mapped_byte_order;
+		header.key_size = key_traits::size;
+		header.string_keys = key_traits::is_string;
+		header.weight_size = weight_traits::size;
+		header.id_size = sizeof(vertex_id);
+		header.vertex_count = keys.size();
+		header.edge_count = targets.size();
+
+		std::uint64_t position = detail::mapped_align(sizeof(header));
+		const auto place = [&](std::uint64_t bytes) {
+			const auto offset = position;
+			position = detail::mapped_align(position + bytes);
+			return offset;
+		};
+
+		header.keys = place(key_bytes);
+		header.key_offsets = key_traits::is_string ? place(key_offsets.size() * sizeof(std::uint64_t)) : 0;
+		header.index = place(index.size() * sizeof(vertex_id));
+		header.offsets = place(offsets.size() * sizeof(std::uint64_t));
+		header.targets = place(targets.size() * sizeof(vertex_id));
+		header.weights = weighted ? place(weights.size() * weight_traits::size) : 0;
+		header.file_size = position;
+
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+
+		std::uint64_t written = 0;
+		const auto write = [&](const void* data, std::uint64_t bytes) {
+			out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+			written += bytes;
+		};
+		const auto pad = [&] {
+			static constexpr char zeros[detail::mapped_alignment] = {};
+			write(zeros, detail::mapped_align(written) - written);
+		};
+
+		write(&header, sizeof(header));
+		pad();
+		if constexpr (key_traits::is_string)
+		{
+			for (const auto key : keys) {
+				write(key->data(), key->size() * key_traits::size);
+			}
+			pad();
+			write(key_offsets.data(), key_offsets.size() * sizeof(std::uint64_t));
+		}
+		else
+		{
+			for (const auto key : keys) {
+				write(key, key_traits::size);
+			}
+		}
+		pad();
+		write(index.data(), index.size() * sizeof(vertex_id));
+		pad();
+		write(offsets.data(), offsets.size() * sizeof(std::uint64_t));
+		pad();
+		write(targets.data(), targets.size() * sizeof(vertex_id));
+		pad();
+		if constexpr (weighted)
+		{
+			write(weights.data(), weights.size() * weight_traits::size);
+			pad();
+		}
+
+		out.close();
+		return !out.fail() && written == header.file_size;
+	}
+}
+
+#endif
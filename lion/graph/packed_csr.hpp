@@ -0,0 +1,9 @@
+#ifndef LION_GRAPH_PACKED_CSR_HPP
+#define LION_GRAPH_PACKED_CSR_HPP
+
+#include "packed_csr/packed_csr_unweighted.hpp"
+#include "packed_csr/packed_csr_weighted.hpp"
+#include "packed_csr/pcsr_vertex_iterator.hpp"
+#include "packed_csr/pcsr_edge_iterator.hpp"
+
+#endif
@@ -0,0 +1,270 @@
+#ifndef LION_GRAPH_PACKED_CSR_WEIGHTED_HPP
+#define LION_GRAPH_PACKED_CSR_WEIGHTED_HPP
+
+#include "../../range.hpp"
+#include "../vertex_interner.hpp"
+#include "../detail/packed_array.hpp"
+
+#include <type_traits>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+namespace lion::graph
+{
+	template<typename Weighted, typename... Ts>
+	class packed_csr;
+
+	// weights live in a second array beside the cells and move with them
+	template<typename Vertex, typename Weight, typename Allocator>
+	class packed_csr<std::true_type, Vertex, Weight, Allocator>
+	{
+	protected:
+		using vertex_type	 = Vertex;
+		using weight_type	 = Weight;
+		using allocator_type = Allocator;
+
+		struct edge_type
+		{
+			vertex_type first;
+			vertex_type second;
+			weight_type weight;
+		};
+
+	private:
+		using id_type = vertex_id;
+
+		using vertices_list = vertex_interner<vertex_type, id_type, allocator_type>;
+		using cell_array = detail::packed_array<id_type, weight_type, allocator_type>;
+
+		using offset_list = std::vector<
+			std::size_t,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<std::size_t>
+		>;
+
+		vertices_list vertices;
+		cell_array cells;
+		offset_list in_degrees;
+
+	protected:
+		using size_type		  = typename vertices_list::size_type;
+		using difference_type = std::ptrdiff_t;
+
+		class vertex_iterator;
+		class edge_iterator;
+
+		explicit packed_csr(const allocator_type& alloc = allocator_type{})
+			: vertices(alloc), cells(alloc), in_degrees(alloc)
+		{}
+
+	private:
+		static constexpr id_type npos = vertices_list::npos;
+
+		struct pending_edge
+		{
+			id_type first;
+			id_type second;
+			weight_type weight;
+		};
+
+		template<typename Key>
+		id_type intern(Key&& vertex)
+		{
+			auto&&[id, succ] = vertices.insert(std::forward<Key>(vertex));
+			if (succ)
+			{
+				cells.add_row();
+				in_degrees.push_back(0);
+			}
+			return id;
+		}
+
+		template<typename W>
+		void link(id_type x, id_type y, W&& weight)
+		{
+			cells.insert(x, y, std::forward<W>(weight));
+			++in_degrees[y];
+		}
+
+	public:
+		void add_edge(const edge_type& edge)
+		{
+			const auto x = intern(edge.first);
+			link(x, intern(edge.second), edge.weight);
+		}
+
+		void add_edge(edge_type&& edge)
+		{
+			const auto x = intern(std::move(edge.first));
+			link(x, intern(std::move(edge.second)), std::move(edge.weight));
+		}
+
+		// a batch as large as a quarter of the graph is placed in one pass
+		// over the array, smaller ones edge by edge
+		template<typename ForwardIterator>
+		void add_edges(ForwardIterator first, ForwardIterator last)
+		{
+			const auto count = static_cast<std::size_t>(std::distance(first, last));
+			if (4 * count < cells.size() + cells.rows())
+			{
+				for (; first != last; ++first) {
+					add_edge(*first);
+				}
+				return;
+			}
+
+			std::vector<
+				pending_edge,
+				typename std::allocator_traits<allocator_type>::template rebind_alloc<pending_edge>
+			> pending(get_allocator());
+
+			pending.reserve(count);
+			for (; first != last; ++first)
+			{
+				const auto& edge = *first;
+				const auto x = intern(edge.first);
+				const auto y = intern(edge.second);
+				pending.push_back({ x, y, edge.weight });
+				++in_degrees[y];
+			}
+			std::stable_sort(pending.begin(), pending.end(), [](const auto& lhs, const auto& rhs) {
+				return lhs.first < rhs.first;
+			});
+			cells.insert_sorted(pending);
+		}
+
+		void add_vertex(const vertex_type& vertex) { intern(vertex); }
+		void add_vertex(vertex_type&& vertex)      { intern(std::move(vertex)); }
+
+		// every edge from first to second goes whatever its weight
+		void remove_edge(const edge_type& edge)
+		{
+			const auto x = vertices.id_of(edge.first);
+			const auto y = vertices.id_of(edge.second);
+			if (x != npos && y != npos) {
+				in_degrees[y] -= cells.erase(x, y);
+			}
+		}
+
+		// the id stays reserved with an empty row until compact()
+		void remove_vertex(const vertex_type& vertex)
+		{
+			const auto id = vertices.id_of(vertex);
+			if (id == npos) {
+				return;
+			}
+
+			cells.clear(id, [this](id_type target) { --in_degrees[target]; });
+			for (std::size_t x = 0; in_degrees[id] && x < vertices.bound(); ++x) {
+				in_degrees[id] -= cells.erase(x, id);
+			}
+			vertices.erase(id);
+		}
+
+		// renumbers the vertices densely, dropping the rows of removed vertices
+		void compact()
+		{
+			const auto remap = vertices.compact();
+			cells.compact(remap);
+
+			// remap[id] <= id, so the degrees can move down in place
+			for (std::size_t id = 0; id < remap.size(); ++id)
+			{
+				if (remap[id] != npos) {
+					in_degrees[remap[id]] = in_degrees[id];
+				}
+			}
+			in_degrees.resize(vertices.bound());
+		}
+
+		bool contains(const vertex_type& vertex) const {
+			return vertices.contains(vertex);
+		}
+
+		vertex_iterator get(const vertex_type& vertex) const {
+			return vertex_iterator(vertices.find(vertex));
+		}
+
+		size_type adjacent(const vertex_type& x, const vertex_type& y, weight_type* weight) const
+		{
+			const auto idxx = vertices.id_of(x);
+			const auto idxy = vertices.id_of(y);
+
+			const auto* data = cells.data();
+			const auto* values = cells.value_data();
+
+			size_type result = 0;
+			for (auto i = cells.row_begin(idxx); i != cells.row_end(idxx); ++i)
+			{
+				if (data[i] == idxy)
+				{
+					++result;
+					if (weight) {
+						*weight = values[i];
+					}
+				}
+			}
+			return result;
+		}
+
+		size_type vertex_count() const noexcept { return vertices.size(); }
+		size_type edge_count()   const noexcept { return cells.size(); }
+
+		size_type degree(const vertex_type& vertex) const
+		{
+			const auto row = targets(vertices.id_of(vertex));
+			return std::distance(row.begin(), row.end());
+		}
+
+		size_type in_degree(const vertex_type& vertex) const { return in_degrees[vertices.id_of(vertex)]; }
+
+		id_type id_of(const vertex_type& vertex) const { return vertices.id_of(vertex); }
+		const vertex_type& key_of(id_type id) const { return vertices.key_of(id); }
+		size_type id_bound() const noexcept { return vertices.bound(); }
+
+		range<detail::gap_iterator<id_type>> targets(id_type id) const noexcept
+		{
+			const auto* data = cells.data();
+			return {
+				detail::gap_iterator<id_type>(data + cells.row_begin(id), data + cells.row_end(id)),
+				detail::gap_iterator<id_type>(data + cells.row_end(id), data + cells.row_end(id))
+			};
+		}
+
+		// parallel to targets(id)
+		range<detail::gap_value_iterator<const weight_type, id_type>> weights(id_type id) const noexcept
+		{
+			const auto* data = cells.data();
+			const auto* values = cells.value_data();
+			return {
+				detail::gap_value_iterator<const weight_type, id_type>(data, values, data + cells.row_begin(id), data + cells.row_end(id)),
+				detail::gap_value_iterator<const weight_type, id_type>(data, values, data + cells.row_end(id), data + cells.row_end(id))
+			};
+		}
+
+		vertex_iterator begin() const noexcept { return vertex_iterator(vertices.begin()); }
+		vertex_iterator end()   const noexcept { return vertex_iterator(vertices.end()); }
+
+		edge_iterator begin(const vertex_type& vert) const noexcept {
+			return edge_iterator(targets(vertices.id_of(vert)).begin(), cells.data(), cells.value_data(), vertices);
+		}
+
+		edge_iterator end(const vertex_type& vert) const noexcept {
+			return edge_iterator(targets(vertices.id_of(vert)).end(), cells.data(), cells.value_data(), vertices);
+		}
+
+		void swap(packed_csr& rhs) noexcept
+		{
+			std::swap(vertices, rhs.vertices);
+			cells.swap(rhs.cells);
+			std::swap(in_degrees, rhs.in_degrees);
+		}
+
+		allocator_type get_allocator() const { return vertices.get_allocator(); }
+	};
+}
+
+#endif
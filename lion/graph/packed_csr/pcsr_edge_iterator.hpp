@@ -0,0 +1,132 @@
+#ifndef LION_GRAPH_PCSR_EDGE_ITERATOR_HPP
+#define LION_GRAPH_PCSR_EDGE_ITERATOR_HPP
+
+#include "packed_csr_unweighted.hpp"
+#include "packed_csr_weighted.hpp"
+
+#include <type_traits>
+#include <iterator>
+#include <memory>
+
+namespace lion::graph
+{
+	// unweighted, skips the gaps of the row
+	template<typename Vertex, typename Weight, typename Allocator>
+	class packed_csr<std::false_type, Vertex, Weight, Allocator>::edge_iterator
+	{
+	private:
+		template<typename Weighted, typename... Ts>
+		friend class packed_csr;
+
+		using list = packed_csr<std::false_type, Vertex, Weight, Allocator>;
+
+		detail::gap_iterator<typename list::id_type> current;
+		const typename list::vertices_list* vertices = nullptr;
+
+		edge_iterator(decltype(current) curr, const typename list::vertices_list& verts)
+			: current(curr), vertices(std::addressof(verts))
+		{}
+
+	public:
+		using value_type		= typename list::vertex_type;
+		using reference			= const value_type&;
+		using pointer			= const value_type*;
+		using difference_type	= std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+
+		edge_iterator() = default;
+		edge_iterator(const edge_iterator&) = default;
+		edge_iterator& operator=(const edge_iterator&) = default;
+
+		edge_iterator& operator++()
+		{
+			++current;
+			return *this;
+		}
+
+		edge_iterator operator++(int)
+		{
+			edge_iterator temp(*this);
+			++current;
+			return temp;
+		}
+
+		reference operator*() const { return vertices->key_of(*current); }
+		pointer operator->()  const { return std::addressof(vertices->key_of(*current)); }
+
+		friend bool operator==(const edge_iterator& lhs, const edge_iterator& rhs) {
+			return lhs.current == rhs.current;
+		}
+		friend bool operator!=(const edge_iterator& lhs, const edge_iterator& rhs) {
+			return !(lhs == rhs);
+		}
+	};
+
+	// weighted, the weight of a cell is at the same index of the value array
+	template<typename Vertex, typename Weight, typename Allocator>
+	class packed_csr<std::true_type, Vertex, Weight, Allocator>::edge_iterator
+	{
+	private:
+		template<typename Weighted, typename... Ts>
+		friend class packed_csr;
+
+		using list = packed_csr<std::true_type, Vertex, Weight, Allocator>;
+
+		detail::gap_iterator<typename list::id_type> current;
+		const typename list::id_type* base = nullptr;
+		const typename list::weight_type* weights = nullptr;
+		const typename list::vertices_list* vertices = nullptr;
+
+		edge_iterator(decltype(current) curr, decltype(base) b, decltype(weights) w, const typename list::vertices_list& verts)
+			: current(curr), base(b), weights(w), vertices(std::addressof(verts))
+		{}
+
+	public:
+		struct value_type
+		{
+			const typename list::vertex_type& second;
+			const typename list::weight_type& weight;
+
+			operator const typename list::vertex_type&() const { return second; }
+		};
+
+		struct pointer
+		{
+			value_type value;
+			const value_type* operator->() const { return std::addressof(value); }
+		};
+
+		using reference			= value_type;
+		using difference_type	= std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+
+		edge_iterator() = default;
+		edge_iterator(const edge_iterator&) = default;
+		edge_iterator& operator=(const edge_iterator&) = default;
+
+		edge_iterator& operator++()
+		{
+			++current;
+			return *this;
+		}
+
+		edge_iterator operator++(int)
+		{
+			edge_iterator temp(*this);
+			++*this;
+			return temp;
+		}
+
+		reference operator*() const { return { vertices->key_of(*current), weights[current.cell() - base] }; }
+		pointer operator->()  const { return { operator*() }; }
+
+		friend bool operator==(const edge_iterator& lhs, const edge_iterator& rhs) {
+			return lhs.current == rhs.current;
+		}
+		friend bool operator!=(const edge_iterator& lhs, const edge_iterator& rhs) {
+			return !(lhs == rhs);
+		}
+	};
+}
+
+#endif
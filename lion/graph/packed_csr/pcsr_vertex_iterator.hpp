@@ -0,0 +1,116 @@
+#ifndef LION_GRAPH_PCSR_VERTEX_ITERATOR_HPP
+#define LION_GRAPH_PCSR_VERTEX_ITERATOR_HPP
+
+#include "packed_csr_unweighted.hpp"
+#include "packed_csr_weighted.hpp"
+
+#include <type_traits>
+#include <iterator>
+#include <memory>
+
+namespace lion::graph
+{
+	// unweighted
+	template<typename Vertex, typename Weight, typename Allocator>
+	class packed_csr<std::false_type, Vertex, Weight, Allocator>::vertex_iterator
+	{
+	private:
+		template<typename Weighted, typename... Ts>
+		friend class packed_csr;
+
+		using list = packed_csr<std::false_type, Vertex, Weight, Allocator>;
+
+		typename list::vertices_list::const_iterator current;
+
+		explicit vertex_iterator(decltype(current) iter)
+			: current(iter)
+		{}
+
+	public:
+		using value_type		= typename list::vertex_type;
+		using reference			= const value_type&;
+		using pointer			= const value_type*;
+		using difference_type	= typename decltype(current)::difference_type;
+		using iterator_category = std::forward_iterator_tag;
+
+		vertex_iterator() = default;
+		vertex_iterator(const vertex_iterator&) = default;
+		vertex_iterator& operator=(const vertex_iterator&) = default;
+
+		vertex_iterator& operator++()
+		{
+			++current;
+			return *this;
+		}
+
+		vertex_iterator operator++(int)
+		{
+			vertex_iterator temp(current);
+			++current;
+			return temp;
+		}
+
+		reference operator*() const { return *current; }
+		pointer operator->()  const { return std::addressof(*current); }
+
+		friend bool operator==(const vertex_iterator& lhs, const vertex_iterator& rhs) {
+			return lhs.current == rhs.current;
+		}
+		friend bool operator!=(const vertex_iterator& lhs, const vertex_iterator& rhs) {
+			return !(lhs == rhs);
+		}
+	};
+
+	// weighted
+	template<typename Vertex, typename Weight, typename Allocator>
+	class packed_csr<std::true_type, Vertex, Weight, Allocator>::vertex_iterator
+	{
+	private:
+		template<typename Weighted, typename... Ts>
+		friend class packed_csr;
+
+		using list = packed_csr<std::true_type, Vertex, Weight, Allocator>;
+
+		typename list::vertices_list::const_iterator current;
+
+		explicit vertex_iterator(decltype(current) iter)
+			: current(iter)
+		{}
+
+	public:
+		using value_type		= typename list::vertex_type;
+		using reference			= const value_type&;
+		using pointer			= const value_type*;
+		using difference_type	= typename decltype(current)::difference_type;
+		using iterator_category = std::forward_iterator_tag;
+
+		vertex_iterator() = default;
+		vertex_iterator(const vertex_iterator&) = default;
+		vertex_iterator& operator=(const vertex_iterator&) = default;
+
+		vertex_iterator& operator++()
+		{
+			++current;
+			return *this;
+		}
+
+		vertex_iterator operator++(int)
+		{
+			vertex_iterator temp(current);
+			++current;
+			return temp;
+		}
+
+		reference operator*() const { return *current; }
+		pointer operator->()  const { return std::addressof(*current); }
+
+		friend bool operator==(const vertex_iterator& lhs, const vertex_iterator& rhs) {
+			return lhs.current == rhs.current;
+		}
+		friend bool operator!=(const vertex_iterator& lhs, const vertex_iterator& rhs) {
+			return !(lhs == rhs);
+		}
+	};
+}
+
+#endif
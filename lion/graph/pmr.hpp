@@ -0,0 +1,69 @@
+#ifndef LION_GRAPH_PMR_HPP
+#define LION_GRAPH_PMR_HPP
+
+#include "../memory/arena.hpp"
+#include "adjacency_list.hpp"
+#include "graph.hpp"
+#include "digraph.hpp"
+#include "wgraph.hpp"
+#include "wdigraph.hpp"
+
+#include <memory_resource>
+#include <type_traits>
+#include <cstddef>
+
+namespace lion::graph
+{
+	namespace detail
+	{
+		// base from member, lets the arena be constructed before the graph
+		struct arena_holder
+		{
+			memory::arena storage;
+
+			arena_holder(std::size_t initial_block, std::pmr::memory_resource* upstream)
+				: storage(initial_block, upstream)
+			{}
+		};
+	}
+
+	// a graph together with the arena every one of its vertices, lists and map
+	// nodes is carved from. the arena outlives the graph, destroying both
+	// frees all storage in a handful of calls. Graph must use an allocator
+	// constructible from memory::arena*, which holds for
+	// std::pmr::polymorphic_allocator and memory::arena_allocator
+	template<typename Graph>
+	class arena_graph : private detail::arena_holder, public Graph
+	{
+	public:
+		explicit arena_graph(std::size_t initial_block = std::size_t(1) << 16,
+			std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+			: detail::arena_holder(initial_block, upstream),
+			  Graph(typename Graph::allocator_type(&storage))
+		{}
+
+		arena_graph(const arena_graph&) = delete;
+		arena_graph& operator=(const arena_graph&) = delete;
+
+		const memory::arena& arena() const noexcept { return storage; }
+	};
+
+	// graphs over std::pmr::polymorphic_allocator, any memory resource works,
+	// including memory::arena and std::pmr::monotonic_buffer_resource
+	namespace pmr
+	{
+		template<typename Vertex, template<typename...> typename Representation = adjacency_list>
+		using graph = lion::graph::graph<Vertex, Representation, std::pmr::polymorphic_allocator<Vertex>>;
+
+		template<typename Vertex, template<typename...> typename Representation = adjacency_list>
+		using digraph = lion::graph::digraph<Vertex, Representation, std::pmr::polymorphic_allocator<Vertex>>;
+
+		template<typename Vertex, typename Weight, template<typename...> typename Representation = adjacency_list>
+		using wgraph = lion::graph::wgraph<Vertex, Weight, Representation, std::pmr::polymorphic_allocator<Vertex>>;
+
+		template<typename Vertex, typename Weight, template<typename...> typename Representation = adjacency_list>
+		using wdigraph = lion::graph::wdigraph<Vertex, Weight, Representation, std::pmr::polymorphic_allocator<Vertex>>;
+	}
+}
+
+#endif
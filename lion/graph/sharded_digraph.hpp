@@ -0,0 +1,463 @@
+#ifndef LION_GRAPH_SHARDED_DIGRAPH_HPP
+#define LION_GRAPH_SHARDED_DIGRAPH_HPP
+
+#include "../range.hpp"
+#include "vertex_interner.hpp"
+#include "detail/parallel.hpp"
+
+#include <unordered_map>
+#include <functional>
+#include <algorithm>
+#include <numeric>
+#include <iterator>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace lion::graph
+{
+	enum class partition_kind
+	{
+		hash,		// by std::hash of the vertex, balanced but blind to edges
+		range,		// contiguous runs of vertices() with about as many edges each
+		edge_cut	// greedy streaming placement next to the most neighbours
+	};
+
+	// a directed graph split over a fixed number of shards that are meant to
+	// be worked on by one thread each. a shard holds its own vertices under
+	// local ids [0, owned()) with their out-edges in csr form, and every
+	// vertex across the cut once as a ghost under ids from owned() on. the
+	// ghost table says which shard owns the ghost and under which id, so
+	// shards exchange messages by id without any shared lookup. the shards
+	// are built in parallel, one thread each, so their arrays are first
+	// touched by a worker and not all on the node of the caller
+	template<typename Vertex, typename Allocator = std::allocator<Vertex>>
+	class sharded_digraph
+	{
+	public:
+		using vertex_type	 = Vertex;
+		using allocator_type = Allocator;
+		using size_type		 = std::size_t;
+		using id_type		 = vertex_id;
+
+		static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+		struct location
+		{
+			std::size_t shard;
+			id_type id;
+		};
+
+		template<typename Message>
+		struct envelope
+		{
+			id_type target;		// local id in the receiving shard
+			Message message;
+		};
+
+	private:
+		template<typename T>
+		using list = std::vector<T, typename std::allocator_traits<allocator_type>::template rebind_alloc<T>>;
+
+	public:
+		class shard_type
+		{
+		private:
+			friend class sharded_digraph;
+
+			std::size_t self = 0;
+			list<vertex_type> keys;
+			list<std::size_t> offsets;
+			list<id_type> columns;
+			list<id_type> ghost_ids;
+			list<std::size_t> ghost_shards;
+
+		public:
+			explicit shard_type(const allocator_type& alloc)
+				: keys(alloc), offsets(1, 0, alloc), columns(alloc), ghost_ids(alloc), ghost_shards(alloc)
+			{}
+
+			std::size_t index() const noexcept { return self; }
+
+			size_type owned() const noexcept { return keys.size(); }
+			size_type ghost_count() const noexcept { return ghost_ids.size(); }
+			size_type id_bound() const noexcept { return owned() + ghost_count(); }
+			size_type edge_count() const noexcept { return columns.size(); }
+
+			bool is_ghost(id_type id) const noexcept { return id >= owned(); }
+
+			// owned vertices only, a ghost's key is at locate(id)
+			const vertex_type& key_of(id_type id) const { return keys[id]; }
+
+			// where a vertex of this shard lives, itself for owned ones
+			location locate(id_type id) const noexcept
+			{
+				if (is_ghost(id)) {
+					return { ghost_shards[id - owned()], ghost_ids[id - owned()] };
+				}
+				return { self, id };
+			}
+
+			// out-edges of an owned vertex, ghosts included
+			range<const id_type*> targets(id_type id) const noexcept {
+				return { columns.data() + offsets[id], columns.data() + offsets[id + 1] };
+			}
+		};
+
+		// what a shard sends during a superstep, read by the receivers in the next one
+		template<typename Message>
+		class outbox
+		{
+		private:
+			friend class sharded_digraph;
+
+			using lane = list<envelope<Message>>;
+
+			const shard_type* shard;
+			lane* lanes;
+			std::size_t sent = 0;
+
+			outbox(const shard_type& s, lane* l) noexcept
+				: shard(std::addressof(s)), lanes(l)
+			{}
+
+		public:
+			// id is in the sender's id space, a ghost's message goes to its owner
+			void send(id_type id, Message message) {
+				send(shard->locate(id), std::move(message));
+			}
+
+			void send(const location& to, Message message)
+			{
+				lanes[to.shard].push_back({ to.id, std::move(message) });
+				++sent;
+			}
+
+			std::size_t size() const noexcept { return sent; }
+		};
+
+	private:
+		using location_map = std::unordered_map<
+			vertex_type,
+			location,
+			std::hash<vertex_type>,
+			std::equal_to<vertex_type>,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<std::pair<const vertex_type, location>>
+		>;
+
+		using index_map = std::unordered_map<
+			vertex_type,
+			std::size_t,
+			std::hash<vertex_type>,
+			std::equal_to<vertex_type>,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<std::pair<const vertex_type, std::size_t>>
+		>;
+
+		list<shard_type> shards;
+		location_map where;
+		size_type edges = 0;
+		size_type cut = 0;
+
+		// shard i of every vertex: a weighted run of [0, n) per shard
+		static void split_ranges(const list<std::size_t>& offsets, std::size_t count, list<std::size_t>& owners)
+		{
+			const std::size_t n = owners.size();
+			const std::size_t total = n + offsets[n];
+
+			std::size_t seen = 0;
+			for (std::size_t v = 0; v < n; ++v)
+			{
+				owners[v] = std::min(count - 1, seen * count / total);
+				seen += 1 + offsets[v + 1] - offsets[v];
+			}
+		}
+
+		// linear deterministic greedy: vertices arrive in breadth first order of
+		// the undirected graph and join the shard holding most of their placed
+		// neighbours, discounted by how full it is. no shard takes more than
+		// 5% over an even share
+		static void split_edge_cut(const list<std::size_t>& offsets, const list<std::size_t>& targets, std::size_t count, list<std::size_t>& owners)
+		{
+			const std::size_t n = owners.size();
+			const auto alloc = owners.get_allocator();
+
+			list<std::size_t> both(n + 1, 0, alloc);
+			for (std::size_t v = 0; v < n; ++v)
+			{
+				for (auto i = offsets[v]; i != offsets[v + 1]; ++i)
+				{
+					++both[v + 1];
+					++both[targets[i] + 1];
+				}
+			}
+			std::partial_sum(both.begin(), both.end(), both.begin());
+
+			list<std::size_t> neighbours(both[n], 0, alloc);
+			list<std::size_t> fill(both.begin(), std::prev(both.end()), alloc);
+			for (std::size_t v = 0; v < n; ++v)
+			{
+				for (auto i = offsets[v]; i != offsets[v + 1]; ++i)
+				{
+					neighbours[fill[v]++] = targets[i];
+					neighbours[fill[targets[i]]++] = v;
+				}
+			}
+
+			const std::size_t capacity = n / count + n / (20 * count) + 1;
+
+			list<std::size_t> sizes(count, 0, alloc);
+			list<std::size_t> votes(count, 0, alloc);
+			list<std::size_t> queue(alloc);
+			queue.reserve(n);
+			std::fill(owners.begin(), owners.end(), npos);
+
+			list<char> queued(n, 0, alloc);
+			for (std::size_t root = 0; root < n; ++root)
+			{
+				if (queued[root]) {
+					continue;
+				}
+				queued[root] = 1;
+				queue.push_back(root);
+
+				for (std::size_t head = queue.size() - 1; head != queue.size(); ++head)
+				{
+					const auto v = queue[head];
+					for (auto i = both[v]; i != both[v + 1]; ++i)
+					{
+						const auto u = neighbours[i];
+						if (owners[u] != npos) {
+							++votes[owners[u]];
+						}
+						if (!queued[u])
+						{
+							queued[u] = 1;
+							queue.push_back(u);
+						}
+					}
+
+					std::size_t best = npos;
+					double score = -1;
+					for (std::size_t s = 0; s < count; ++s)
+					{
+						if (sizes[s] >= capacity) {
+							continue;
+						}
+						const double current = votes[s] * (1.0 - static_cast<double>(sizes[s]) / capacity);
+						if (current > score || (current == score && sizes[s] < sizes[best]))
+						{
+							best = s;
+							score = current;
+						}
+					}
+					owners[v] = best;
+					++sizes[best];
+					std::fill(votes.begin(), votes.end(), 0);
+				}
+			}
+		}
+
+	public:
+		// copies graph into count shards, any graph with vertices() and edges(v)
+		template<typename Graph>
+		sharded_digraph(const Graph& graph, std::size_t count, partition_kind kind = partition_kind::hash,
+			const allocator_type& alloc = allocator_type{})
+			: shards(alloc), where(alloc)
+		{
+			count = std::max<std::size_t>(count, 1);
+
+			list<const vertex_type*> keys(alloc);
+			index_map index(alloc);
+			for (const auto& vertex : graph.vertices())
+			{
+				index.emplace(vertex, keys.size());
+				keys.push_back(std::addressof(vertex));
+			}
+
+			const std::size_t n = keys.size();
+
+			list<std::size_t> offsets(1, 0, alloc);
+			list<std::size_t> targets(alloc);
+			offsets.reserve(n + 1);
+			for (const auto* key : keys)
+			{
+				for (const auto& edge : graph.edges(*key)) {
+					targets.push_back(index.find(static_cast<const vertex_type&>(edge))->second);
+				}
+				offsets.push_back(targets.size());
+			}
+			index.clear();
+			edges = targets.size();
+
+			list<std::size_t> owners(n, 0, alloc);
+			if (n != 0)
+			{
+				switch (kind)
+				{
+				case partition_kind::hash:
+					for (std::size_t v = 0; v < n; ++v) {
+						owners[v] = std::hash<vertex_type>{}(*keys[v]) % count;
+					}
+					break;
+				case partition_kind::range:
+					split_ranges(offsets, count, owners);
+					break;
+				case partition_kind::edge_cut:
+					split_edge_cut(offsets, targets, count, owners);
+					break;
+				}
+			}
+
+			// local ids follow the global order within every shard
+			list<id_type> local(n, 0, alloc);
+			std::vector<list<std::size_t>> members(count, list<std::size_t>(alloc));
+			for (std::size_t v = 0; v < n; ++v)
+			{
+				local[v] = static_cast<id_type>(members[owners[v]].size());
+				members[owners[v]].push_back(v);
+			}
+
+			where.reserve(n);
+			for (std::size_t v = 0; v < n; ++v) {
+				where.emplace(*keys[v], location{ owners[v], local[v] });
+			}
+			for (std::size_t v = 0; v < n; ++v)
+			{
+				for (auto i = offsets[v]; i != offsets[v + 1]; ++i) {
+					cut += owners[targets[i]] != owners[v];
+				}
+			}
+
+			shards.reserve(count);
+			for (std::size_t s = 0; s < count; ++s) {
+				shards.emplace_back(alloc);
+			}
+
+			detail::parallel_for(count, count, [&](std::size_t first, std::size_t last, std::size_t) {
+				for (auto s = first; s != last; ++s)
+				{
+					auto& shard = shards[s];
+					const auto& mine = members[s];
+					shard.self = s;
+
+					std::unordered_map<std::size_t, id_type> ghosts;
+					shard.keys.reserve(mine.size());
+					shard.offsets.reserve(mine.size() + 1);
+					for (const auto v : mine)
+					{
+						shard.keys.push_back(*keys[v]);
+						for (auto i = offsets[v]; i != offsets[v + 1]; ++i)
+						{
+							const auto t = targets[i];
+							if (owners[t] == s)
+							{
+								shard.columns.push_back(local[t]);
+								continue;
+							}
+							const auto[ghost, fresh] = ghosts.emplace(t, static_cast<id_type>(mine.size() + shard.ghost_ids.size()));
+							if (fresh)
+							{
+								shard.ghost_ids.push_back(local[t]);
+								shard.ghost_shards.push_back(owners[t]);
+							}
+							shard.columns.push_back(ghost->second);
+						}
+						shard.offsets.push_back(shard.columns.size());
+					}
+				}
+			});
+		}
+
+		std::size_t shard_count() const noexcept { return shards.size(); }
+		const shard_type& operator[](std::size_t shard) const noexcept { return shards[shard]; }
+
+		size_type vertex_count() const noexcept { return where.size(); }
+		size_type edge_count() const noexcept { return edges; }
+
+		// edges whose endpoints live in different shards
+		size_type cut_edges() const noexcept { return cut; }
+
+		bool contains(const vertex_type& vertex) const { return where.find(vertex) != where.end(); }
+
+		// shard and local id of vertex, shard is npos when there is none
+		location locate(const vertex_type& vertex) const
+		{
+			const auto find = where.find(vertex);
+			return find != where.end() ? find->second : location{ npos, vertex_interner<vertex_type, id_type, allocator_type>::npos };
+		}
+
+		const vertex_type& key_of(const location& at) const { return shards[at.shard].key_of(at.id); }
+
+		// f(shard) for every shard, each on its own thread
+		template<typename Function>
+		void for_each_shard(Function&& f) const
+		{
+			detail::parallel_for(shards.size(), shards.size(), [&](std::size_t first, std::size_t last, std::size_t) {
+				for (auto s = first; s != last; ++s) {
+					f(shards[s]);
+				}
+			});
+		}
+
+		// bulk synchronous supersteps with one thread per shard. every superstep
+		// calls step(shard, inbox, out, superstep) on each shard, where inbox
+		// holds the envelopes sent to the shard in the previous superstep and
+		// the result says whether the shard has work left without any mail.
+		// stops once no shard has work and nothing was sent, or after max_steps.
+		// returns the number of supersteps run
+		template<typename Message, typename Step>
+		std::size_t run(Step&& step, std::size_t max_steps = npos) const
+		{
+			using lane = list<envelope<Message>>;
+
+			const std::size_t count = shards.size();
+
+			// lanes[from * count + to]
+			std::vector<lane> lanes(count * count, lane(get_allocator()));
+			std::vector<char> busy(count, 0);
+			std::vector<std::size_t> sent(count, 0);
+			std::size_t steps = 0;
+
+			detail::barrier sync(count);
+			detail::parallel_for(count, count, [&](std::size_t self, std::size_t, std::size_t) {
+				lane inbox(get_allocator());
+				for (std::size_t superstep = 0; superstep < max_steps; ++superstep)
+				{
+					// receivers drain their column of lanes, senders only fill their row
+					inbox.clear();
+					for (std::size_t from = 0; from < count; ++from)
+					{
+						auto& in = lanes[from * count + self];
+						std::move(in.begin(), in.end(), std::back_inserter(inbox));
+						in.clear();
+					}
+					sync.wait();
+
+					outbox<Message> out(shards[self], lanes.data() + self * count);
+					busy[self] = step(shards[self], range<const envelope<Message>*>{ inbox.data(), inbox.data() + inbox.size() }, out, superstep);
+					sent[self] = out.size();
+					sync.wait();
+
+					// every thread reaches the same verdict, busy and sent only
+					// change again after the next barrier
+					bool more = false;
+					for (std::size_t s = 0; s < count; ++s) {
+						more = more || busy[s] || sent[s];
+					}
+					if (self == 0) {
+						steps = superstep + 1;
+					}
+					if (!more) {
+						break;
+					}
+				}
+			});
+			return steps;
+		}
+
+		allocator_type get_allocator() const { return shards.get_allocator(); }
+	};
+}
+
+#endif
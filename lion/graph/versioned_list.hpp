@@ -0,0 +1,10 @@
+#ifndef LION_GRAPH_VERSIONED_LIST_HPP
+#define LION_GRAPH_VERSIONED_LIST_HPP
+
+#include "versioned_list/versioned_list_unweighted.hpp"
+#include "versioned_list/versioned_list_weighted.hpp"
+#include "versioned_list/vlist_vertex_iterator.hpp"
+#include "versioned_list/vlist_edge_iterator.hpp"
+#include "versioned_list/vlist_snapshot.hpp"
+
+#endif
@@ -0,0 +1,372 @@
+#ifndef LION_GRAPH_VERSIONED_LIST_UNWEIGHTED_HPP
+#define LION_GRAPH_VERSIONED_LIST_UNWEIGHTED_HPP
+
+#include "../../range.hpp"
+#include "../vertex_interner.hpp"
+#include "../detail/cow_ptr.hpp"
+#include "../detail/id_index.hpp"
+
+#include <type_traits>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+namespace lion::graph
+{
+	template<typename Weighted, typename... Ts>
+	class versioned_list;
+
+	// adjacency lists in copy-on-write blocks of block_size vertices, so a
+	// copy of the graph costs one pointer per block. snapshot() hands out
+	// such a copy as a read-only graph, the next write to a block the
+	// snapshot still shares copies the block and then only the touched rows.
+	// snapshots may be read on other threads while this graph keeps changing,
+	// snapshot() itself is a write and belongs with the other writes
+	template<typename Vertex, typename Weight, typename Allocator>
+	class versioned_list<std::false_type, Vertex, Weight, Allocator>
+	{
+	protected:
+		using vertex_type	 = Vertex;
+		using allocator_type = Allocator;
+
+		struct edge_type
+		{
+			vertex_type first;
+			vertex_type second;
+		};
+
+	private:
+		using id_type = vertex_id;
+
+		static constexpr id_type npos = static_cast<id_type>(-1);
+		static constexpr std::size_t block_size = 256;
+
+		using id_list = std::vector<
+			id_type,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<id_type>
+		>;
+
+		struct row
+		{
+			id_list targets;
+			std::size_t in_degree = 0;
+			bool alive = false;
+
+			explicit row(const allocator_type& alloc)
+				: targets(alloc)
+			{}
+
+			row(const row& rhs, const allocator_type& alloc)
+				: targets(rhs.targets, alloc), in_degree(rhs.in_degree), alive(rhs.alive)
+			{}
+		};
+
+		using row_ptr = detail::cow_ptr<row, allocator_type>;
+
+		struct row_block
+		{
+			row_ptr rows[block_size];
+
+			explicit row_block(const allocator_type&) {}
+
+			row_block(const row_block& rhs, const allocator_type&) {
+				std::copy(std::begin(rhs.rows), std::end(rhs.rows), std::begin(rows));
+			}
+		};
+
+		// keys are never changed once written, so full blocks of them are
+		// shared for good. the last one is appended to through write(), a
+		// copy of the graph that still shares it appends to a copy of its own
+		struct key_block
+		{
+			allocator_type alloc;
+			std::size_t count = 0;
+			alignas(vertex_type) unsigned char storage[block_size * sizeof(vertex_type)];
+
+			explicit key_block(const allocator_type& al)
+				: alloc(al)
+			{}
+
+			key_block(const key_block& rhs, const allocator_type& al)
+				: key_block(al)
+			{
+				for (std::size_t i = 0; i < rhs.count; ++i) {
+					emplace(rhs.slot(i));
+				}
+			}
+
+			~key_block()
+			{
+				for (std::size_t i = 0; i < count; ++i) {
+					std::allocator_traits<allocator_type>::destroy(alloc, std::launder(reinterpret_cast<vertex_type*>(storage) + i));
+				}
+			}
+
+			const vertex_type& slot(std::size_t i) const noexcept {
+				return *std::launder(reinterpret_cast<const vertex_type*>(storage) + i);
+			}
+
+			template<typename V>
+			void emplace(V&& vertex)
+			{
+				std::allocator_traits<allocator_type>::construct(alloc, reinterpret_cast<vertex_type*>(storage) + count, std::forward<V>(vertex));
+				++count;
+			}
+		};
+
+		// one index for the graph and every copy of it, see id_index
+		using index_type = detail::id_index<vertex_type, allocator_type>;
+
+		template<typename T>
+		using block_list = std::vector<
+			detail::cow_ptr<T, allocator_type>,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<detail::cow_ptr<T, allocator_type>>
+		>;
+
+		block_list<key_block> keys;
+		block_list<row_block> rows;
+		std::shared_ptr<index_type> index;
+		std::size_t bound = 0;
+		std::size_t live = 0;
+		std::size_t edges = 0;
+
+	protected:
+		using size_type		  = std::size_t;
+		using difference_type = std::ptrdiff_t;
+
+		class vertex_iterator;
+		class edge_iterator;
+
+		explicit versioned_list(const allocator_type& alloc = allocator_type{})
+			: keys(alloc), rows(alloc), index(std::allocate_shared<index_type>(alloc, alloc))
+		{}
+
+	private:
+		auto key_reader() const noexcept {
+			return [this](id_type id) -> const vertex_type& { return key_of(id); };
+		}
+
+		const row* find_row(id_type id) const noexcept
+		{
+			const auto& current = rows[id / block_size]->rows[id % block_size];
+			return current ? &*current : nullptr;
+		}
+
+		row& write_row(id_type id)
+		{
+			auto& current = rows[id / block_size].write().rows[id % block_size];
+			if (!current) {
+				current = row_ptr::make(get_allocator(), get_allocator());
+			}
+			return current.write();
+		}
+
+		template<typename V>
+		id_type intern(V&& vertex)
+		{
+			const auto found = id_of(vertex);
+			if (found != npos)
+			{
+				const auto* current = find_row(found);
+				if (!current || !current->alive)
+				{
+					write_row(found).alive = true;
+					++live;
+				}
+				return found;
+			}
+
+			const auto id = static_cast<id_type>(bound);
+			if (bound % block_size == 0)
+			{
+				keys.push_back(detail::cow_ptr<key_block, allocator_type>::make(get_allocator(), get_allocator()));
+				rows.push_back(detail::cow_ptr<row_block, allocator_type>::make(get_allocator(), get_allocator()));
+			}
+			keys.back().write().emplace(std::forward<V>(vertex));
+			// a copy that fell behind another writer sharing the index builds its own
+			if (!index->claim(id))
+			{
+				index = std::allocate_shared<index_type>(get_allocator(), get_allocator(), bound, key_reader());
+				index->claim(id);
+			}
+			index->append(id, key_reader());
+			++bound;
+
+			write_row(id).alive = true;
+			++live;
+			return id;
+		}
+
+		void link(id_type x, id_type y)
+		{
+			write_row(x).targets.push_back(y);
+			++write_row(y).in_degree;
+			++edges;
+		}
+
+		// erases every entry equal to id, returns how many were erased
+		static std::size_t unlink(id_list& list, id_type id)
+		{
+			const auto last = std::remove(list.begin(), list.end(), id);
+			const auto removed = static_cast<std::size_t>(list.end() - last);
+			list.erase(last, list.end());
+			return removed;
+		}
+
+	public:
+		void add_edge(const edge_type& edge)
+		{
+			const auto x = intern(edge.first);
+			link(x, intern(edge.second));
+		}
+
+		void add_edge(edge_type&& edge)
+		{
+			const auto x = intern(std::move(edge.first));
+			link(x, intern(std::move(edge.second)));
+		}
+
+		template<typename ForwardIterator>
+		void add_edges(ForwardIterator first, ForwardIterator last)
+		{
+			for (; first != last; ++first) {
+				add_edge(*first);
+			}
+		}
+
+		void add_vertex(const vertex_type& vertex) { intern(vertex); }
+		void add_vertex(vertex_type&& vertex)      { intern(std::move(vertex)); }
+
+		// only the row of the source is copied, and only if it is shared
+		void remove_edge(const edge_type& edge)
+		{
+			const auto x = id_of(edge.first);
+			const auto y = id_of(edge.second);
+
+			const auto* current = x != npos && y != npos ? find_row(x) : nullptr;
+			if (!current || std::find(current->targets.begin(), current->targets.end(), y) == current->targets.end()) {
+				return;
+			}
+
+			const auto removed = unlink(write_row(x).targets, y);
+			write_row(y).in_degree -= removed;
+			edges -= removed;
+		}
+
+		// rows are read first and copied only when they hold an edge into vertex,
+		// the scan stops once every incoming edge is accounted for
+		void remove_vertex(const vertex_type& vertex)
+		{
+			const auto id = id_of(vertex);
+			const auto* self = id != npos ? find_row(id) : nullptr;
+			if (!self || !self->alive) {
+				return;
+			}
+
+			id_list targets(self->targets, get_allocator());
+			for (const auto target : targets) {
+				--write_row(target).in_degree;
+			}
+			edges -= targets.size();
+
+			auto& mine = write_row(id);
+			mine.targets.clear();
+			mine.alive = false;
+			auto incoming = mine.in_degree;
+			--live;
+
+			for (std::size_t x = 0; incoming && x < bound; ++x)
+			{
+				const auto* current = find_row(static_cast<id_type>(x));
+				if (!current || std::find(current->targets.begin(), current->targets.end(), id) == current->targets.end()) {
+					continue;
+				}
+				const auto removed = unlink(write_row(static_cast<id_type>(x)).targets, id);
+				write_row(id).in_degree -= removed;
+				incoming -= removed;
+				edges -= removed;
+			}
+		}
+
+		class snapshot_type;
+
+		// a read-only graph of the current state sharing every block with this one
+		snapshot_type snapshot() const { return snapshot_type(*this); }
+
+		bool contains(const vertex_type& vertex) const
+		{
+			const auto id = id_of(vertex);
+			const auto* current = id != npos ? find_row(id) : nullptr;
+			return current && current->alive;
+		}
+
+		vertex_iterator get(const vertex_type& vertex) const {
+			return contains(vertex) ? vertex_iterator(*this, id_of(vertex)) : end();
+		}
+
+		size_type adjacent(const vertex_type& x, const vertex_type& y) const
+		{
+			const auto targets = this->targets(id_of(x));
+			return std::count(targets.begin(), targets.end(), id_of(y));
+		}
+
+		size_type vertex_count() const noexcept { return live; }
+		size_type edge_count()   const noexcept { return edges; }
+
+		size_type degree(const vertex_type& vertex) const
+		{
+			const auto* current = find_row(id_of(vertex));
+			return current ? current->targets.size() : 0;
+		}
+
+		size_type in_degree(const vertex_type& vertex) const
+		{
+			const auto* current = find_row(id_of(vertex));
+			return current ? current->in_degree : 0;
+		}
+
+		id_type id_of(const vertex_type& vertex) const
+		{
+			return index->find(vertex, bound, key_reader());
+		}
+
+		const vertex_type& key_of(id_type id) const { return keys[id / block_size]->slot(id % block_size); }
+		size_type id_bound() const noexcept { return bound; }
+
+		range<const id_type*> targets(id_type id) const noexcept
+		{
+			const auto* current = find_row(id);
+			if (!current) {
+				return { nullptr, nullptr };
+			}
+			return { current->targets.data(), current->targets.data() + current->targets.size() };
+		}
+
+		vertex_iterator begin() const noexcept { return vertex_iterator(*this, 0); }
+		vertex_iterator end()   const noexcept { return vertex_iterator(*this, bound); }
+
+		edge_iterator begin(const vertex_type& vert) const noexcept {
+			return edge_iterator(targets(id_of(vert)).begin(), *this);
+		}
+		edge_iterator end(const vertex_type& vert) const noexcept {
+			return edge_iterator(targets(id_of(vert)).end(), *this);
+		}
+
+		void swap(versioned_list& rhs) noexcept
+		{
+			std::swap(keys, rhs.keys);
+			std::swap(rows, rhs.rows);
+			std::swap(index, rhs.index);
+			std::swap(bound, rhs.bound);
+			std::swap(live, rhs.live);
+			std::swap(edges, rhs.edges);
+		}
+
+		allocator_type get_allocator() const { return keys.get_allocator(); }
+	};
+}
+
+#endif
@@ -0,0 +1,123 @@
+#ifndef LION_GRAPH_VLIST_SNAPSHOT_HPP
+#define LION_GRAPH_VLIST_SNAPSHOT_HPP
+
+#include "../../range.hpp"
+#include "versioned_list_unweighted.hpp"
+#include "versioned_list_weighted.hpp"
+#include "vlist_vertex_iterator.hpp"
+#include "vlist_edge_iterator.hpp"
+
+#include <type_traits>
+#include <utility>
+
+namespace lion::graph
+{
+	// unweighted, a frozen copy of the list with only the read side public.
+	// it is a graph of its own, every algorithm that takes a graph takes it
+	template<typename Vertex, typename Weight, typename Allocator>
+	class versioned_list<std::false_type, Vertex, Weight, Allocator>::snapshot_type
+		: private versioned_list<std::false_type, Vertex, Weight, Allocator>
+	{
+	private:
+		template<typename Weighted, typename... Ts>
+		friend class versioned_list;
+
+		using list = versioned_list<std::false_type, Vertex, Weight, Allocator>;
+
+		explicit snapshot_type(const list& source)
+			: list(source)
+		{}
+
+	public:
+		using vertex_type	  = typename list::vertex_type;
+		using allocator_type  = typename list::allocator_type;
+		using size_type		  = typename list::size_type;
+		using difference_type = typename list::difference_type;
+		using vertex_iterator = typename list::vertex_iterator;
+		using edge_iterator	  = typename list::edge_iterator;
+
+		snapshot_type(const snapshot_type&) = default;
+		snapshot_type(snapshot_type&&) = default;
+		snapshot_type& operator=(const snapshot_type&) = default;
+		snapshot_type& operator=(snapshot_type&&) = default;
+
+		using list::contains;
+		using list::get;
+		using list::adjacent;
+		using list::vertex_count;
+		using list::edge_count;
+		using list::degree;
+		using list::in_degree;
+		using list::id_of;
+		using list::key_of;
+		using list::id_bound;
+		using list::targets;
+		using list::begin;
+		using list::end;
+		using list::get_allocator;
+
+		range<vertex_iterator> vertices() const noexcept {
+			return { this->begin(), this->end() };
+		}
+
+		range<edge_iterator> edges(const vertex_type& vert) const noexcept {
+			return { this->begin(vert), this->end(vert) };
+		}
+	};
+
+	// weighted
+	template<typename Vertex, typename Weight, typename Allocator>
+	class versioned_list<std::true_type, Vertex, Weight, Allocator>::snapshot_type
+		: private versioned_list<std::true_type, Vertex, Weight, Allocator>
+	{
+	private:
+		template<typename Weighted, typename... Ts>
+		friend class versioned_list;
+
+		using list = versioned_list<std::true_type, Vertex, Weight, Allocator>;
+
+		explicit snapshot_type(const list& source)
+			: list(source)
+		{}
+
+	public:
+		using vertex_type	  = typename list::vertex_type;
+		using weight_type	  = typename list::weight_type;
+		using allocator_type  = typename list::allocator_type;
+		using size_type		  = typename list::size_type;
+		using difference_type = typename list::difference_type;
+		using vertex_iterator = typename list::vertex_iterator;
+		using edge_iterator	  = typename list::edge_iterator;
+
+		snapshot_type(const snapshot_type&) = default;
+		snapshot_type(snapshot_type&&) = default;
+		snapshot_type& operator=(const snapshot_type&) = default;
+		snapshot_type& operator=(snapshot_type&&) = default;
+
+		using list::contains;
+		using list::get;
+		using list::adjacent;
+		using list::vertex_count;
+		using list::edge_count;
+		using list::degree;
+		using list::in_degree;
+		using list::id_of;
+		using list::key_of;
+		using list::id_bound;
+		using list::targets;
+		using list::weights;
+		using list::begin;
+		using list::end;
+		using list::get_allocator;
+
+		range<vertex_iterator> vertices() const noexcept {
+			return { this->begin(), this->end() };
+		}
+
+		range<edge_iterator> edges(const vertex_type& vert) const noexcept {
+			return { this->begin(vert), this->end(vert) };
+		}
+	};
+}
+
+#endif
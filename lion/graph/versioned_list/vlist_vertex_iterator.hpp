@@ -0,0 +1,149 @@
+#ifndef LION_GRAPH_VLIST_VERTEX_ITERATOR_HPP
+#define LION_GRAPH_VLIST_VERTEX_ITERATOR_HPP
+
+#include "versioned_list_unweighted.hpp"
+#include "versioned_list_weighted.hpp"
+
+#include <type_traits>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+
+namespace lion::graph
+{
+	// unweighted, visits the ids in order and skips removed ones
+	template<typename Vertex, typename Weight, typename Allocator>
+	class versioned_list<std::false_type, Vertex, Weight, Allocator>::vertex_iterator
+	{
+	private:
+		template<typename Weighted, typename... Ts>
+		friend class versioned_list;
+
+		using list = versioned_list<std::false_type, Vertex, Weight, Allocator>;
+
+		const list* owner = nullptr;
+		std::size_t current = 0;
+
+		vertex_iterator(const list& l, std::size_t id)
+			: owner(std::addressof(l)), current(id)
+		{
+			skip();
+		}
+
+		void skip()
+		{
+			while (current < owner->bound)
+			{
+				const auto* row = owner->find_row(static_cast<typename list::id_type>(current));
+				if (row && row->alive) {
+					break;
+				}
+				++current;
+			}
+		}
+
+	public:
+		using value_type		= typename list::vertex_type;
+		using reference			= const value_type&;
+		using pointer			= const value_type*;
+		using difference_type	= std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+
+		vertex_iterator() = default;
+		vertex_iterator(const vertex_iterator&) = default;
+		vertex_iterator& operator=(const vertex_iterator&) = default;
+
+		vertex_iterator& operator++()
+		{
+			++current;
+			skip();
+			return *this;
+		}
+
+		vertex_iterator operator++(int)
+		{
+			vertex_iterator temp(*this);
+			++*this;
+			return temp;
+		}
+
+		reference operator*() const { return owner->key_of(static_cast<typename list::id_type>(current)); }
+		pointer operator->()  const { return std::addressof(operator*()); }
+
+		friend bool operator==(const vertex_iterator& lhs, const vertex_iterator& rhs) {
+			return lhs.current == rhs.current;
+		}
+		friend bool operator!=(const vertex_iterator& lhs, const vertex_iterator& rhs) {
+			return !(lhs == rhs);
+		}
+	};
+
+	// weighted
+	template<typename Vertex, typename Weight, typename Allocator>
+	class versioned_list<std::true_type, Vertex, Weight, Allocator>::vertex_iterator
+	{
+	private:
+		template<typename Weighted, typename... Ts>
+		friend class versioned_list;
+
+		using list = versioned_list<std::true_type, Vertex, Weight, Allocator>;
+
+		const list* owner = nullptr;
+		std::size_t current = 0;
+
+		vertex_iterator(const list& l, std::size_t id)
+			: owner(std::addressof(l)), current(id)
+		{
+			skip();
+		}
+
+		void skip()
+		{
+			while (current < owner->bound)
+			{
+				const auto* row = owner->find_row(static_cast<typename list::id_type>(current));
+				if (row && row->alive) {
+					break;
+				}
+				++current;
+			}
+		}
+
+	public:
+		using value_type		= typename list::vertex_type;
+		using reference			= const value_type&;
+		using pointer			= const value_type*;
+		using difference_type	= std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+
+		vertex_iterator() = default;
+		vertex_iterator(const vertex_iterator&) = default;
+		vertex_iterator& operator=(const vertex_iterator&) = default;
+
+		vertex_iterator& operator++()
+		{
+			++current;
+			skip();
+			return *this;
+		}
+
+		vertex_iterator operator++(int)
+		{
+			vertex_iterator temp(*this);
+			++*this;
+			return temp;
+		}
+
+		reference operator*() const { return owner->key_of(static_cast<typename list::id_type>(current)); }
+		pointer operator->()  const { return std::addressof(operator*()); }
+
+		friend bool operator==(const vertex_iterator& lhs, const vertex_iterator& rhs) {
+			return lhs.current == rhs.current;
+		}
+		friend bool operator!=(const vertex_iterator& lhs, const vertex_iterator& rhs) {
+			return !(lhs == rhs);
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,297 @@
+#ifndef LION_GRAPH_VERTEX_INTERNER_HPP
+#define LION_GRAPH_VERTEX_INTERNER_HPP
+
+#include <type_traits>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+namespace lion::graph
+{
+#ifdef LION_GRAPH_64BIT_IDS
+	using vertex_id = std::uint64_t;
+#else
+	using vertex_id = std::uint32_t;
+#endif
+
+	// edge ids are positions in flat edge arrays, this one means no edge
+	inline constexpr std::size_t npos_edge = static_cast<std::size_t>(-1);
+
+	// maps user vertex keys to contiguous ids [0, bound()) and back,
+	// ids are handed out in insertion order. erase() leaves a tombstone
+	// so the remaining ids stay put until compact() is called
+	template<typename Vertex, typename Id = vertex_id, typename Allocator = std::allocator<Vertex>>
+	class vertex_interner
+	{
+	public:
+		using key_type		 = Vertex;
+		using id_type		 = Id;
+		using allocator_type = Allocator;
+
+	private:
+		using key_list = std::vector<
+			key_type,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<key_type>
+		>;
+
+		using dead_list = std::vector<
+			char,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<char>
+		>;
+
+		using id_map = std::unordered_map<
+			key_type,
+			id_type,
+			std::hash<key_type>,
+			std::equal_to<key_type>,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<
+				std::pair<const key_type, id_type>
+			>
+		>;
+
+		key_list keys;
+		dead_list dead;
+		id_map ids;
+		std::size_t erased = 0;
+
+	public:
+		using size_type = typename key_list::size_type;
+
+		using remap_type = std::vector<
+			id_type,
+			typename std::allocator_traits<allocator_type>::template rebind_alloc<id_type>
+		>;
+
+		class const_iterator;
+
+		static constexpr id_type npos = static_cast<id_type>(-1);
+
+		explicit vertex_interner(const allocator_type& alloc = allocator_type{})
+			: keys(alloc), dead(alloc), ids(alloc)
+		{}
+
+		std::pair<id_type, bool> insert(const key_type& key)
+		{
+			auto&&[it, succ] = ids.insert({ key, static_cast<id_type>(keys.size()) });
+			if (succ)
+			{
+				keys.push_back(key);
+				dead.push_back(0);
+			}
+			return { it->second, succ };
+		}
+
+		std::pair<id_type, bool> insert(key_type&& key)
+		{
+			auto&&[it, succ] = ids.insert({ key, static_cast<id_type>(keys.size()) });
+			if (succ)
+			{
+				keys.push_back(std::move(key));
+				dead.push_back(0);
+			}
+			return { it->second, succ };
+		}
+
+		void erase(id_type id)
+		{
+			ids.erase(keys[id]);
+			dead[id] = 1;
+			++erased;
+		}
+
+		// closes the gaps left by erase(), the result maps every old id
+		// to its new one, or to npos for erased ids
+		remap_type compact()
+		{
+			remap_type remap(keys.size(), npos, keys.get_allocator());
+
+			id_type next = 0;
+			for (std::size_t id = 0; id < keys.size(); ++id)
+			{
+				if (!dead[id])
+				{
+					remap[id] = next;
+					if (next != id)
+					{
+						keys[next] = std::move(keys[id]);
+						ids.find(keys[next])->second = next;
+					}
+					++next;
+				}
+			}
+
+			keys.erase(std::next(keys.begin(), next), keys.end());
+			dead.assign(next, 0);
+			erased = 0;
+
+			return remap;
+		}
+
+		// renumbers the keys so that order[i] gets id i, ids missing from order
+		// are erased. the result maps every old id to its new one or to npos
+		template<typename Order>
+		remap_type permute(const Order& order)
+		{
+			remap_type remap(keys.size(), npos, keys.get_allocator());
+			for (std::size_t i = 0; i < order.size(); ++i) {
+				remap[order[i]] = static_cast<id_type>(i);
+			}
+			for (std::size_t id = 0; id < keys.size(); ++id)
+			{
+				if (!dead[id] && remap[id] == npos) {
+					ids.erase(keys[id]);
+				}
+			}
+
+			key_list next(keys.get_allocator());
+			next.reserve(order.size());
+			for (std::size_t i = 0; i < order.size(); ++i)
+			{
+				next.push_back(std::move(keys[order[i]]));
+				ids.find(next.back())->second = static_cast<id_type>(i);
+			}
+
+			keys.swap(next);
+			dead.assign(keys.size(), 0);
+			erased = 0;
+
+			return remap;
+		}
+
+		id_type id_of(const key_type& key) const
+		{
+			const auto find = ids.find(key);
+			return find != ids.end() ? find->second : npos;
+		}
+
+		const key_type& key_of(id_type id) const { return keys[id]; }
+
+		bool contains(const key_type& key) const {
+			return ids.find(key) != ids.end();
+		}
+
+		bool alive(id_type id) const noexcept { return !dead[id]; }
+
+		// live keys
+		size_type size() const noexcept { return keys.size() - erased; }
+		bool empty() const noexcept { return size() == 0; }
+
+		// one past the largest id handed out so far, tombstones included
+		size_type bound() const noexcept { return keys.size(); }
+
+		void reserve(size_type count)
+		{
+			keys.reserve(count);
+			dead.reserve(count);
+			ids.reserve(count);
+		}
+
+		void clear() noexcept
+		{
+			keys.clear();
+			dead.clear();
+			ids.clear();
+			erased = 0;
+		}
+
+		const_iterator find(const key_type& key) const
+		{
+			const auto find = ids.find(key);
+			return const_iterator(*this, find != ids.end() ? find->second : keys.size());
+		}
+
+		const_iterator begin() const noexcept { return const_iterator(*this, 0); }
+		const_iterator end()   const noexcept { return const_iterator(*this, keys.size()); }
+
+		friend bool operator==(const vertex_interner& lhs, const vertex_interner& rhs) {
+			return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+		}
+		friend bool operator!=(const vertex_interner& lhs, const vertex_interner& rhs) {
+			return !(lhs == rhs);
+		}
+
+		void swap(vertex_interner& rhs) noexcept(
+			noexcept(std::swap(keys, rhs.keys)) &&
+			noexcept(std::swap(dead, rhs.dead)) &&
+			noexcept(std::swap(ids, rhs.ids)))
+		{
+			std::swap(keys, rhs.keys);
+			std::swap(dead, rhs.dead);
+			std::swap(ids, rhs.ids);
+			std::swap(erased, rhs.erased);
+		}
+
+		allocator_type get_allocator() const { return keys.get_allocator(); }
+	};
+
+	// visits the live keys in id order
+	template<typename Vertex, typename Id, typename Allocator>
+	class vertex_interner<Vertex, Id, Allocator>::const_iterator
+	{
+	private:
+		friend class vertex_interner;
+
+		const vertex_interner* interner = nullptr;
+		std::size_t current = 0;
+
+		const_iterator(const vertex_interner& in, std::size_t id)
+			: interner(std::addressof(in)), current(id)
+		{
+			skip_dead();
+		}
+
+		void skip_dead()
+		{
+			while (current < interner->keys.size() && interner->dead[current]) {
+				++current;
+			}
+		}
+
+	public:
+		using value_type		= typename vertex_interner::key_type;
+		using reference			= const value_type&;
+		using pointer			= const value_type*;
+		using difference_type	= std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+
+		const_iterator() = default;
+		const_iterator(const const_iterator&) = default;
+		const_iterator& operator=(const const_iterator&) = default;
+
+		const_iterator& operator++()
+		{
+			++current;
+			skip_dead();
+			return *this;
+		}
+
+		const_iterator operator++(int)
+		{
+			const_iterator temp(*this);
+			++*this;
+			return temp;
+		}
+
+		reference operator*() const { return interner->keys[current]; }
+		pointer operator->()  const { return std::addressof(interner->keys[current]); }
+
+		typename vertex_interner::id_type id() const noexcept {
+			return static_cast<typename vertex_interner::id_type>(current);
+		}
+
+		friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) {
+			return lhs.current == rhs.current;
+		}
+		friend bool operator!=(const const_iterator& lhs, const const_iterator& rhs) {
+			return !(lhs == rhs);
+		}
+	};
+}
+
+#endif
@@ -47,21 +47,7 @@ namespace lion::graph
 		wdigraph(ForwardIterator first, ForwardIterator last, const allocator_type& alloc = allocator_type{})
 			: representation_type(alloc)
 		{
-			for (; first != last; ++first) {
-				add_edge(*first);
-			}
-		}
-
-		void add_edge(const edge_type& edge)
-		{
-			representation_type::add_edge(edge);
-			representation_type::add_vertex(edge.second);
-		}
-
-		void add_edge(edge_type&& edge) 
-		{
-			representation_type::add_edge({ std::move(edge.first), edge.second, std::move(edge.weight) });
-			representation_type::add_vertex(std::move(edge.second));
+			representation_type::add_edges(first, last);
 		}
 
 		range<vertex_iterator> vertices() const noexcept {
@@ -8,6 +8,9 @@
 #include <type_traits>
 #include <initializer_list>
 #include <utility>
+#include <cstddef>
+#include <iterator>
+#include <vector>
 
 namespace lion::graph
 {
@@ -47,9 +50,7 @@ namespace lion::graph
 		wgraph(ForwardIterator first, ForwardIterator last, const allocator_type& alloc = allocator_type{})
 			: representation_type(alloc)
 		{
-			for (; first != last; ++first) {
-				add_edge(*first);
-			}
+			add_edges(first, last);
 		}
 
 		void add_edge(const edge_type& edge) 
@@ -64,6 +65,22 @@ namespace lion::graph
 			representation_type::add_edge(std::move(edge));
 		}
 
+		// both directions go to the representation as one batch so it can use its bulk
+		// path, the batch is handed over by move so nothing copies it a second time
+		template<typename ForwardIterator>
+		void add_edges(ForwardIterator first, ForwardIterator last)
+		{
+			std::vector<edge_type, typename std::allocator_traits<allocator_type>::template rebind_alloc<edge_type>> both(this->get_allocator());
+			both.reserve(2 * static_cast<std::size_t>(std::distance(first, last)));
+			for (; first != last; ++first)
+			{
+				const edge_type& edge = *first;
+				both.push_back(edge);
+				both.push_back({ edge.second, edge.first, edge.weight });
+			}
+			representation_type::add_edges(std::make_move_iterator(both.begin()), std::make_move_iterator(both.end()));
+		}
+
 		void remove_edge(const edge_type& edge)
 		{
 			representation_type::remove_edge(edge);
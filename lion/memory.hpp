@@ -0,0 +1,6 @@
+#ifndef LION_MEMORY_HPP
+#define LION_MEMORY_HPP
+
+#include "memory/arena.hpp"
+
+#endif
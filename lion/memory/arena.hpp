@@ -0,0 +1,196 @@
+#ifndef LION_MEMORY_ARENA_HPP
+#define LION_MEMORY_ARENA_HPP
+
+#include <memory_resource>
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <algorithm>
+
+namespace lion::memory
+{
+	// bump allocator over blocks taken from an upstream resource. deallocate
+	// does nothing, every byte is handed back at once by release() or when the
+	// arena is destroyed. blocks grow geometrically up to max_block and requests
+	// larger than that get a block of their own. not thread safe
+	class arena : public std::pmr::memory_resource
+	{
+	private:
+		// sits at the start of every block, the blocks form a stack
+		struct block
+		{
+			block* previous;
+			std::size_t size;
+		};
+
+		static constexpr std::size_t header = (sizeof(block) + alignof(std::max_align_t) - 1) /
+			alignof(std::max_align_t) * alignof(std::max_align_t);
+
+		std::pmr::memory_resource* upstream;
+		block* blocks = nullptr;
+		unsigned char* current = nullptr;
+		std::size_t remaining = 0;
+		std::size_t next_block;
+		std::size_t first_block;
+		std::size_t used = 0;
+		std::size_t reserved = 0;
+
+	public:
+		static constexpr std::size_t max_block = std::size_t(1) << 26;
+
+		explicit arena(std::size_t initial_block = std::size_t(1) << 16,
+			std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) noexcept
+			: upstream(upstream),
+			  next_block(std::clamp<std::size_t>(initial_block, header + alignof(std::max_align_t), max_block)),
+			  first_block(next_block)
+		{}
+
+		arena(const arena&) = delete;
+		arena& operator=(const arena&) = delete;
+
+		~arena() { release(); }
+
+		// the hot path, not virtual so arena_allocator can inline it
+		void* carve(std::size_t bytes, std::size_t alignment)
+		{
+			const auto address = reinterpret_cast<std::uintptr_t>(current);
+			const auto padding = (alignment - address % alignment) % alignment;
+			if (bytes + padding > remaining || !current) {
+				return grow(bytes, alignment);
+			}
+			current += padding;
+			void* result = current;
+			current += bytes;
+			remaining -= bytes + padding;
+			used += bytes;
+			return result;
+		}
+
+		// frees every block, anything allocated from the arena is gone
+		void release() noexcept
+		{
+			while (blocks)
+			{
+				const auto previous = blocks->previous;
+				upstream->deallocate(blocks, blocks->size, alignof(std::max_align_t));
+				blocks = previous;
+			}
+			current = nullptr;
+			remaining = 0;
+			next_block = first_block;
+			used = 0;
+			reserved = 0;
+		}
+
+		// bytes handed out and bytes taken from upstream, headers and padding included
+		std::size_t bytes_used() const noexcept { return used; }
+		std::size_t bytes_reserved() const noexcept { return reserved; }
+
+		std::pmr::memory_resource* upstream_resource() const noexcept { return upstream; }
+
+	private:
+		void* grow(std::size_t bytes, std::size_t alignment)
+		{
+			const auto needed = header + bytes + alignment;
+			const auto size = std::max(needed, next_block);
+
+			auto fresh = static_cast<block*>(upstream->allocate(size, alignof(std::max_align_t)));
+			fresh->size = size;
+			reserved += size;
+
+			// an oversized block goes below the current one so the space left
+			// in the current block is not thrown away
+			if (size > next_block && blocks && remaining > 0)
+			{
+				fresh->previous = blocks->previous;
+				blocks->previous = fresh;
+
+				const auto address = reinterpret_cast<std::uintptr_t>(fresh) + header;
+				const auto padding = (alignment - address % alignment) % alignment;
+				used += bytes;
+				return reinterpret_cast<unsigned char*>(fresh) + header + padding;
+			}
+
+			fresh->previous = blocks;
+			blocks = fresh;
+			current = reinterpret_cast<unsigned char*>(fresh) + header;
+			remaining = size - header;
+			next_block = std::min(next_block * 2, max_block);
+
+			return carve(bytes, alignment);
+		}
+
+	protected:
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+			return carve(bytes, alignment);
+		}
+
+		void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+			return this == &other;
+		}
+	};
+
+	// an allocator that carves straight from an arena without going through
+	// the virtual memory_resource interface. a default constructed one has no
+	// arena and behaves like std::allocator, so scratch containers that
+	// default construct their allocator keep working
+	template<typename T>
+	class arena_allocator
+	{
+	private:
+		template<typename U>
+		friend class arena_allocator;
+
+		arena* source = nullptr;
+
+	public:
+		using value_type = T;
+
+		using propagate_on_container_copy_assignment = std::false_type;
+		using propagate_on_container_move_assignment = std::true_type;
+		using propagate_on_container_swap			 = std::true_type;
+
+		arena_allocator() noexcept = default;
+		arena_allocator(arena* a) noexcept : source(a) {}
+		arena_allocator(arena& a) noexcept : source(std::addressof(a)) {}
+
+		template<typename U>
+		arena_allocator(const arena_allocator<U>& rhs) noexcept : source(rhs.source) {}
+
+		T* allocate(std::size_t count)
+		{
+			if (count > std::size_t(-1) / sizeof(T)) {
+				throw std::bad_array_new_length();
+			}
+			if (source) {
+				return static_cast<T*>(source->carve(count * sizeof(T), alignof(T)));
+			}
+			return std::allocator<T>{}.allocate(count);
+		}
+
+		void deallocate(T* pointer, std::size_t count) noexcept
+		{
+			if (!source) {
+				std::allocator<T>{}.deallocate(pointer, count);
+			}
+		}
+
+		arena* resource() const noexcept { return source; }
+
+		template<typename U>
+		friend bool operator==(const arena_allocator& lhs, const arena_allocator<U>& rhs) noexcept {
+			return lhs.source == rhs.source;
+		}
+		template<typename U>
+		friend bool operator!=(const arena_allocator& lhs, const arena_allocator<U>& rhs) noexcept {
+			return lhs.source != rhs.source;
+		}
+	};
+}
+
+#endif